@@ -1,6 +1,7 @@
 #ifndef __MDVECTOR_CALCULATION_EXPR_H__
 #define __MDVECTOR_CALCULATION_EXPR_H__
 
+#include "owned_expr.h"
 #include "scalar_expr.h"
 
 namespace md {
@@ -15,6 +16,12 @@ struct tensor_scalar_type<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
   using type = scalar_wrapper<T>;
 };
 
+// 右值操作数按值保存
+template <class E>
+struct tensor_scalar_type<owned_expr<E>> {
+  using type = owned_expr<E>;
+};
+
 template <class T>
 using AutoType = typename tensor_scalar_type<T>::type;
 
@@ -24,7 +31,8 @@ class calculation_expr : public tensor_expr<calculation_expr<T, L, R, Cal>, T> {
   AutoType<R> rhs;
 
  public:
-  calculation_expr(const L& l, const R& r) : lhs(l), rhs(r) {}
+  template <class LA, class RA>
+  calculation_expr(LA&& l, RA&& r) : lhs(std::forward<LA>(l)), rhs(std::forward<RA>(r)) {}
 
   size_t used_size() const {
     if constexpr (std::is_arithmetic_v<R>) {
@@ -42,6 +50,29 @@ class calculation_expr : public tensor_expr<calculation_expr<T, L, R, Cal>, T> {
     }
   }
 
+  // 遍历所有操作数的数据区 f(const T* data, size_t n)
+  template <class F>
+  void visit_data(F&& f) const {
+    if constexpr (!std::is_arithmetic_v<L>) {
+      lhs.visit_data(f);
+    }
+    if constexpr (!std::is_arithmetic_v<R>) {
+      rhs.visit_data(f);
+    }
+  }
+
+  // 在按值保存的操作数中查找形状为dims的右值V
+  template <class V, class Dims>
+  V* reusable_buffer(const Dims& dims) noexcept {
+    if constexpr (is_owned_expr_v<L>) {
+      if (V* v = lhs.template reusable_buffer<V>(dims)) return v;
+    }
+    if constexpr (is_owned_expr_v<R>) {
+      return rhs.template reusable_buffer<V>(dims);
+    }
+    return nullptr;
+  }
+
   template <class T>
   typename simd<T>::type eval_simd(size_t i) const {
     auto l = lhs.template eval_simd<T>(i);
@@ -5,76 +5,78 @@
 
 namespace md {
 
+// 操作数按operand_t保存: 左值引用 右值mdvector与右值表达式节点移动进表达式树
+
 // 向量 + 向量
-template <class T, class L, class R>
-auto operator+(const tensor_expr<L, T>& lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, L, R, Add>(lhs.derived(), rhs.derived());
+template <class L, class R, class T = expr_value_t<L>, class = std::enable_if_t<std::is_same_v<T, expr_value_t<R>>>>
+auto operator+(L&& lhs, R&& rhs) {
+  return calculation_expr<T, operand_t<L>, operand_t<R>, Add>(forward_operand<L>(lhs), forward_operand<R>(rhs));
 }
 
 // 向量 + 标量
-template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator+(const tensor_expr<L, T>& lhs, const T& rhs) {
-  return calculation_expr<T, L, T, Add>(lhs.derived(), rhs);
+template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<L>>>>
+auto operator+(L&& lhs, T rhs) {
+  return calculation_expr<T, operand_t<L>, T, Add>(forward_operand<L>(lhs), rhs);
 }
 
 // 标量 + 向量
-template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator+(T lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, T, R, Add>(lhs, rhs.derived());
+template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<R>>>>
+auto operator+(T lhs, R&& rhs) {
+  return calculation_expr<T, T, operand_t<R>, Add>(lhs, forward_operand<R>(rhs));
 }
 
 // 向量 - 向量
-template <class T, class L, class R>
-auto operator-(const tensor_expr<L, T>& lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, L, R, Sub>(lhs.derived(), rhs.derived());
+template <class L, class R, class T = expr_value_t<L>, class = std::enable_if_t<std::is_same_v<T, expr_value_t<R>>>>
+auto operator-(L&& lhs, R&& rhs) {
+  return calculation_expr<T, operand_t<L>, operand_t<R>, Sub>(forward_operand<L>(lhs), forward_operand<R>(rhs));
 }
 
 // 向量 - 标量
-template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator-(const tensor_expr<L, T>& lhs, T rhs) {
-  return calculation_expr<T, L, T, Sub>(lhs.derived(), rhs);
+template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<L>>>>
+auto operator-(L&& lhs, T rhs) {
+  return calculation_expr<T, operand_t<L>, T, Sub>(forward_operand<L>(lhs), rhs);
 }
 
 // 标量 - 向量
-template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator-(T lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, T, R, Sub>(lhs, rhs.derived());
+template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<R>>>>
+auto operator-(T lhs, R&& rhs) {
+  return calculation_expr<T, T, operand_t<R>, Sub>(lhs, forward_operand<R>(rhs));
 }
 
 // 向量 * 向量
-template <class T, class L, class R>
-auto operator*(const tensor_expr<L, T>& lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, L, R, Mul>(lhs.derived(), rhs.derived());
+template <class L, class R, class T = expr_value_t<L>, class = std::enable_if_t<std::is_same_v<T, expr_value_t<R>>>>
+auto operator*(L&& lhs, R&& rhs) {
+  return calculation_expr<T, operand_t<L>, operand_t<R>, Mul>(forward_operand<L>(lhs), forward_operand<R>(rhs));
 }
 
 // 向量 * 标量
-template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator*(const tensor_expr<L, T>& lhs, T rhs) {
-  return calculation_expr<T, L, T, Mul>(lhs.derived(), rhs);
+template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<L>>>>
+auto operator*(L&& lhs, T rhs) {
+  return calculation_expr<T, operand_t<L>, T, Mul>(forward_operand<L>(lhs), rhs);
 }
 
 // 标量 * 向量
-template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator*(T lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, T, R, Mul>(lhs, rhs.derived());
+template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<R>>>>
+auto operator*(T lhs, R&& rhs) {
+  return calculation_expr<T, T, operand_t<R>, Mul>(lhs, forward_operand<R>(rhs));
 }
 
 // 向量 / 向量
-template <class T, class L, class R>
-auto operator/(const tensor_expr<L, T>& lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, L, R, Div>(lhs.derived(), rhs.derived());
+template <class L, class R, class T = expr_value_t<L>, class = std::enable_if_t<std::is_same_v<T, expr_value_t<R>>>>
+auto operator/(L&& lhs, R&& rhs) {
+  return calculation_expr<T, operand_t<L>, operand_t<R>, Div>(forward_operand<L>(lhs), forward_operand<R>(rhs));
 }
 
 // 向量 / 标量
-template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator/(const tensor_expr<L, T>& lhs, T rhs) {
-  return calculation_expr<T, L, T, Mul>(lhs.derived(), static_cast<T>(1.0) / rhs);
+template <class L, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<L>>>>
+auto operator/(L&& lhs, T rhs) {
+  return calculation_expr<T, operand_t<L>, T, Mul>(forward_operand<L>(lhs), static_cast<T>(1.0) / rhs);
 }
 
 // 标量 / 向量
-template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto operator/(T lhs, const tensor_expr<R, T>& rhs) {
-  return calculation_expr<T, T, R, Div>(lhs, rhs.derived());
+template <class R, class T, class = std::enable_if_t<std::is_arithmetic_v<T> && std::is_same_v<T, expr_value_t<R>>>>
+auto operator/(T lhs, R&& rhs) {
+  return calculation_expr<T, T, operand_t<R>, Div>(lhs, forward_operand<R>(rhs));
 }
 
 }  // namespace md
@@ -0,0 +1,123 @@
+#ifndef __MDVECTOR_OWNED_EXPR_H__
+#define __MDVECTOR_OWNED_EXPR_H__
+
+#include <type_traits>
+#include <utility>
+
+#include "tensor_expr.h"
+
+namespace md {
+
+template <class T, class L, class R, class Cal>
+class calculation_expr;
+
+template <class E>
+struct is_calculation_expr : std::false_type {};
+
+template <class T, class L, class R, class Cal>
+struct is_calculation_expr<calculation_expr<T, L, R, Cal>> : std::true_type {};
+
+template <class E>
+inline constexpr bool is_calculation_expr_v = is_calculation_expr<E>::value;
+
+// 右值作为操作数时可以移动进表达式树的类型 默认只有表达式节点
+// mdvector在mdvector.h中特化
+template <class E>
+struct is_movable_operand : is_calculation_expr<E> {};
+
+// 按值保存的操作数(右值mdvector或右值表达式节点)
+// 表达式树随完整表达式结束而销毁 其中的mdvector内存可以被结果直接接管
+template <class E>
+class owned_expr {
+  E value_;
+
+ public:
+  explicit owned_expr(E&& value) noexcept : value_(std::move(value)) {}
+
+  owned_expr(owned_expr&&) noexcept = default;
+
+  owned_expr(const owned_expr&) = delete;
+  owned_expr& operator=(const owned_expr&) = delete;
+
+  size_t used_size() const { return value_.used_size(); }
+
+  auto extents() const { return value_.extents(); }
+
+  template <class F>
+  void visit_data(F&& f) const {
+    value_.visit_data(f);
+  }
+
+  template <class U>
+  typename simd<U>::type eval_simd(size_t i) const {
+    return value_.template eval_simd<U>(i);
+  }
+
+  template <class U>
+  typename simd<U>::type eval_simd_mask(size_t i) const {
+    return value_.template eval_simd_mask<U>(i);
+  }
+
+  // 查找形状为dims的右值V 结果可以在其内存上原地计算后接管
+  template <class V, class Dims>
+  V* reusable_buffer(const Dims& dims) noexcept {
+    if constexpr (std::is_same_v<E, V>) {
+      return value_.extents() == dims ? &value_ : nullptr;
+    } else if constexpr (is_calculation_expr_v<E>) {
+      return value_.template reusable_buffer<V>(dims);
+    } else {
+      return nullptr;
+    }
+  }
+};
+
+template <class E>
+struct is_owned_expr : std::false_type {};
+
+template <class E>
+struct is_owned_expr<owned_expr<E>> : std::true_type {};
+
+template <class E>
+inline constexpr bool is_owned_expr_v = is_owned_expr<E>::value;
+
+// 表达式的元素类型 E不是表达式时替换失败
+template <class D, class T>
+T expr_value_of(const tensor_expr<D, T>*);
+
+template <class E>
+using expr_value_t = decltype(expr_value_of(std::declval<const std::decay_t<E>*>()));
+
+// 以tensor_expr基类引用传入时还原为派生类型
+template <class E>
+struct expr_derived {
+  using type = E;
+};
+
+template <class D, class T>
+struct expr_derived<tensor_expr<D, T>> {
+  using type = D;
+};
+
+template <class E>
+using expr_derived_t = typename expr_derived<std::decay_t<E>>::type;
+
+// 操作数在表达式树中的保存方式: 非const右值且可移动时按值保存 其余按引用保存
+template <class E>
+using operand_t = std::conditional_t<!std::is_lvalue_reference_v<E> && !std::is_const_v<std::remove_reference_t<E>> &&
+                                         is_movable_operand<expr_derived_t<E>>::value,
+                                     owned_expr<expr_derived_t<E>>, expr_derived_t<E>>;
+
+// 保持值类别转发为派生类型
+template <class E>
+decltype(auto) forward_operand(std::remove_reference_t<E>& e) noexcept {
+  using D = std::conditional_t<std::is_const_v<std::remove_reference_t<E>>, const expr_derived_t<E>, expr_derived_t<E>>;
+  if constexpr (std::is_lvalue_reference_v<E>) {
+    return static_cast<D&>(e);
+  } else {
+    return static_cast<D&&>(e);
+  }
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_OWNED_EXPR_H__
@@ -1,6 +1,8 @@
 #ifndef __MDVECTOR_SCALAR_EXPR_H__
 #define __MDVECTOR_SCALAR_EXPR_H__
 
+#include <array>
+
 #include "tensor_expr.h"
 
 namespace md {
@@ -14,6 +16,8 @@ class scalar_wrapper : public tensor_expr<scalar_wrapper<T>, T> {
 
   scalar_wrapper(const scalar_wrapper &) = delete;
 
+  scalar_wrapper(scalar_wrapper &&) noexcept = default;
+
   template <class U>
   typename simd<U>::type eval_simd(size_t) const {
     return simd_value_;
@@ -0,0 +1,61 @@
+#ifndef __MDVECTOR_STATIC_EVAL_H__
+#define __MDVECTOR_STATIC_EVAL_H__
+
+#include <type_traits>
+#include <utility>
+
+#include "calculation_expr.h"
+
+namespace md {
+
+// 编译期补齐长度 0表示操作数长度在运行期才确定
+// 定长操作数通过静态成员padded_size声明 其数据simd对齐且已补齐到包长整数倍
+template <class E, class = void>
+struct static_padded_size : std::integral_constant<size_t, 0> {};
+
+template <class E>
+struct static_padded_size<E, std::void_t<decltype(E::padded_size)>> : std::integral_constant<size_t, E::padded_size> {};
+
+template <class T, class L, class R, class Cal>
+struct static_padded_size<calculation_expr<T, L, R, Cal>> {
+  static constexpr size_t value = std::is_arithmetic_v<L>   ? static_padded_size<R>::value
+                                  : std::is_arithmetic_v<R> ? static_padded_size<L>::value
+                                  : static_padded_size<L>::value == static_padded_size<R>::value
+                                      ? static_padded_size<L>::value
+                                      : 0;
+};
+
+template <class E>
+struct static_padded_size<owned_expr<E>> : static_padded_size<E> {};
+
+// 表达式所有操作数均补齐到N
+template <class E, size_t N>
+inline constexpr bool is_padded_expr_v = N != 0 && static_padded_size<E>::value == N;
+
+// 不超过该包数时完全展开
+inline constexpr size_t static_unroll_packs = 16;
+
+template <class T, class E, size_t... I>
+inline void eval_static_unrolled(T* dest, const E& expr, std::index_sequence<I...>) noexcept {
+  constexpr size_t pack_size = simd<T>::pack_size;
+  (simd<T>::store(dest + I * pack_size, expr.template eval_simd<T>(I * pack_size)), ...);
+}
+
+// 编译期长度计算 全部为对齐读写 补齐部分已存在 无需尾部掩码
+template <size_t N, class T, class E>
+inline void eval_static(T* dest, const E& expr) noexcept {
+  constexpr size_t pack_size = simd<T>::pack_size;
+  static_assert(N % pack_size == 0, "eval_static: N must be a multiple of pack_size");
+
+  if constexpr (N / pack_size <= static_unroll_packs) {
+    eval_static_unrolled(dest, expr, std::make_index_sequence<N / pack_size>{});
+  } else {
+    for (size_t i = 0; i < N; i += pack_size) {
+      simd<T>::store(dest + i, expr.template eval_simd<T>(i));
+    }
+  }
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_STATIC_EVAL_H__
@@ -10,6 +10,8 @@ class tensor_expr {
  public:
   const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
 
+  Derived& derived() noexcept { return static_cast<Derived&>(*this); }
+
   size_t used_size() const noexcept { return derived().used_size(); }
 
   auto extents() const noexcept { return derived().extents(); }
@@ -18,18 +20,25 @@ class tensor_expr {
 
   template <class Dest, class DestPolicy>
   void eval_to(Dest* dest) const noexcept {
-    const size_t n = used_size();
-    constexpr size_t pack_size = simd<Dest>::pack_size;
-    size_t i = 0;
+    eval_to_range<Dest, DestPolicy>(dest, 0, used_size());
+  }
 
-    for (; i + pack_size <= n; i += pack_size) {
+  // 计算[begin, end)区间 begin与非末尾的end需为pack_size整数倍 尾部掩码仅在末尾处理
+  template <class Dest, class DestPolicy>
+  void eval_to_range(Dest* dest, size_t begin, size_t end) const noexcept {
+    constexpr size_t pack_size = simd<std::remove_const_t<Dest>>::pack_size;
+    size_t i = begin;
+
+    for (; i + pack_size <= end; i += pack_size) {
       auto simd_val = derived().template eval_simd<std::remove_const_t<Dest>>(i);
       DestPolicy::template store<std::remove_const_t<Dest>>(dest + i, simd_val);
     }
 
-    const size_t remaining = n - i;
-    auto simd_val = derived().template eval_simd_mask<std::remove_const_t<Dest>>(i);
-    DestPolicy::template mask_store<std::remove_const_t<Dest>>(dest + i, remaining, simd_val);
+    if (i < end) {
+      const size_t remaining = end - i;
+      auto simd_val = derived().template eval_simd_mask<std::remove_const_t<Dest>>(i);
+      DestPolicy::template mask_store<std::remove_const_t<Dest>>(dest + i, remaining, simd_val);
+    }
   }
 };
 
@@ -0,0 +1,843 @@
+#ifndef __MDVECTOR_NPY_H__
+#define __MDVECTOR_NPY_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mdarray.h"
+#include "mdvector.h"
+
+namespace md {
+
+// ======================== dtype ========================
+// numpy dtype描述符 仅支持小端平台
+template <class T>
+struct npy_dtype;
+
+template <>
+struct npy_dtype<float> {
+  static constexpr const char* descr = "<f4";
+};
+template <>
+struct npy_dtype<double> {
+  static constexpr const char* descr = "<f8";
+};
+template <>
+struct npy_dtype<bool> {
+  static constexpr const char* descr = "|b1";
+};
+template <>
+struct npy_dtype<int8_t> {
+  static constexpr const char* descr = "|i1";
+};
+template <>
+struct npy_dtype<uint8_t> {
+  static constexpr const char* descr = "|u1";
+};
+template <>
+struct npy_dtype<int16_t> {
+  static constexpr const char* descr = "<i2";
+};
+template <>
+struct npy_dtype<uint16_t> {
+  static constexpr const char* descr = "<u2";
+};
+template <>
+struct npy_dtype<int32_t> {
+  static constexpr const char* descr = "<i4";
+};
+template <>
+struct npy_dtype<uint32_t> {
+  static constexpr const char* descr = "<u4";
+};
+template <>
+struct npy_dtype<int64_t> {
+  static constexpr const char* descr = "<i8";
+};
+template <>
+struct npy_dtype<uint64_t> {
+  static constexpr const char* descr = "<u8";
+};
+
+// ======================== 文件头 ========================
+struct npy_header {
+  std::string descr;
+  bool fortran_order = false;
+  std::vector<size_t> shape;
+  size_t data_offset = 0;  // 数据区相对文件头起点的偏移
+
+  size_t total_size() const {
+    size_t n = 1;
+    for (auto s : shape) {
+      n *= s;
+    }
+    return n;
+  }
+};
+
+// 单次读写块大小 避免部分平台单次fread/fwrite超过2GB出错
+constexpr size_t npy_io_chunk = size_t(1) << 26;
+
+// numpy要求数据区按64字节对齐 同时满足所有指令集的对齐要求
+constexpr size_t npy_data_alignment = 64;
+
+using npy_file = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+inline npy_file npy_open(const std::string& path, const char* mode) {
+  npy_file fp(std::fopen(path.c_str(), mode), &std::fclose);
+  if (!fp) {
+    throw std::runtime_error("npy: cannot open file " + path);
+  }
+  return fp;
+}
+
+inline void npy_write_all(std::FILE* fp, const void* data, size_t bytes) {
+  const char* p = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const size_t n = bytes < npy_io_chunk ? bytes : npy_io_chunk;
+    if (std::fwrite(p, 1, n, fp) != n) {
+      throw std::runtime_error("npy: write failed");
+    }
+    p += n;
+    bytes -= n;
+  }
+}
+
+inline void npy_read_all(std::FILE* fp, void* data, size_t bytes) {
+  char* p = static_cast<char*>(data);
+  while (bytes > 0) {
+    const size_t n = bytes < npy_io_chunk ? bytes : npy_io_chunk;
+    if (std::fread(p, 1, n, fp) != n) {
+      throw std::runtime_error("npy: unexpected end of file");
+    }
+    p += n;
+    bytes -= n;
+  }
+}
+
+// 生成完整文件头(含魔数) 总长度对齐到64字节
+inline std::string make_npy_header(const char* descr, bool fortran_order, const size_t* shape, size_t rank) {
+  std::string dict = std::string("{'descr': '") + descr + "', 'fortran_order': " + (fortran_order ? "True" : "False") +
+                     ", 'shape': (";
+  for (size_t i = 0; i < rank; ++i) {
+    dict += std::to_string(shape[i]);
+    if (rank == 1 || i + 1 < rank) {
+      dict += ",";
+    }
+    if (i + 1 < rank) {
+      dict += " ";
+    }
+  }
+  dict += "), }";
+
+  // 魔数6 + 版本2 + 长度2(v1.0)或4(v2.0)
+  size_t prefix = 10;
+  if (dict.size() + 1 + prefix > 65535) {
+    prefix = 12;
+  }
+  const size_t total = prefix + dict.size() + 1;
+  const size_t padded = (total + npy_data_alignment - 1) / npy_data_alignment * npy_data_alignment;
+  dict.append(padded - total, ' ');
+  dict += '\n';
+
+  std::string res("\x93NUMPY", 6);
+  const size_t len = dict.size();
+  if (prefix == 10) {
+    res += static_cast<char>(1);
+    res += static_cast<char>(0);
+    res += static_cast<char>(len & 0xff);
+    res += static_cast<char>((len >> 8) & 0xff);
+  } else {
+    res += static_cast<char>(2);
+    res += static_cast<char>(0);
+    for (int i = 0; i < 4; ++i) {
+      res += static_cast<char>((len >> (8 * i)) & 0xff);
+    }
+  }
+  return res + dict;
+}
+
+// 解析python字典形式的文件头
+inline npy_header parse_npy_dict(const std::string& dict) {
+  npy_header header;
+
+  auto value_pos = [&dict](const char* key) {
+    size_t pos = dict.find(key);
+    if (pos == std::string::npos) {
+      throw std::runtime_error(std::string("npy: header missing ") + key);
+    }
+    pos = dict.find(':', pos);
+    if (pos == std::string::npos) {
+      throw std::runtime_error("npy: malformed header");
+    }
+    return dict.find_first_not_of(' ', pos + 1);
+  };
+
+  size_t pos = value_pos("'descr'");
+  const char quote = dict.at(pos);
+  const size_t end = dict.find(quote, pos + 1);
+  if (end == std::string::npos) {
+    throw std::runtime_error("npy: malformed descr");
+  }
+  header.descr = dict.substr(pos + 1, end - pos - 1);
+
+  pos = value_pos("'fortran_order'");
+  header.fortran_order = dict.compare(pos, 4, "True") == 0;
+
+  pos = value_pos("'shape'");
+  const size_t close = dict.find(')', pos);
+  if (dict.at(pos) != '(' || close == std::string::npos) {
+    throw std::runtime_error("npy: malformed shape");
+  }
+  for (size_t i = pos + 1; i < close;) {
+    if (dict[i] >= '0' && dict[i] <= '9') {
+      size_t len = 0;
+      header.shape.push_back(std::stoull(dict.substr(i, close - i), &len));
+      i += len;
+    } else {
+      ++i;
+    }
+  }
+  return header;
+}
+
+// 从当前文件位置读取文件头 读取完成后文件位置即为数据区起点
+inline npy_header read_npy_header(std::FILE* fp) {
+  char magic[8];
+  npy_read_all(fp, magic, 8);
+  if (std::memcmp(magic, "\x93NUMPY", 6) != 0) {
+    throw std::runtime_error("npy: bad magic string");
+  }
+
+  size_t len = 0;
+  size_t prefix = 10;
+  unsigned char buf[4] = {0};
+  if (magic[6] == 1) {
+    npy_read_all(fp, buf, 2);
+    len = buf[0] | (size_t(buf[1]) << 8);
+  } else if (magic[6] == 2 || magic[6] == 3) {
+    npy_read_all(fp, buf, 4);
+    len = buf[0] | (size_t(buf[1]) << 8) | (size_t(buf[2]) << 16) | (size_t(buf[3]) << 24);
+    prefix = 12;
+  } else {
+    throw std::runtime_error("npy: unsupported format version");
+  }
+
+  std::string dict(len, '\0');
+  npy_read_all(fp, &dict[0], len);
+
+  npy_header header = parse_npy_dict(dict);
+  header.data_offset = prefix + len;
+  return header;
+}
+
+// 布局对应的fortran_order 分块布局需先转换为行优先再读写
+template <class Layout>
+constexpr bool npy_fortran_order() noexcept {
+  static_assert(!is_tiled_layout_v<Layout>, "npy: convert tiled layout to row-major first");
+  return std::is_same_v<Layout, layout_left>;
+}
+
+// 检查dtype/维度/布局 返回extents
+template <class T, size_t Rank, class Layout>
+std::array<size_t, Rank> check_npy_header(const npy_header& header) {
+  const std::string expect = npy_dtype<T>::descr;
+  // '<' '|' '=' 在小端平台上等价
+  if (header.descr.size() != expect.size() || header.descr[0] == '>' ||
+      header.descr.compare(1, std::string::npos, expect, 1, std::string::npos) != 0) {
+    throw std::runtime_error("npy: dtype mismatch, file is " + header.descr + ", expected " + expect);
+  }
+  if (header.shape.size() != Rank) {
+    throw std::runtime_error("npy: rank mismatch");
+  }
+  if (header.fortran_order != npy_fortran_order<Layout>()) {
+    throw std::runtime_error("npy: fortran_order does not match layout");
+  }
+  std::array<size_t, Rank> extents;
+  std::copy(header.shape.begin(), header.shape.end(), extents.begin());
+  return extents;
+}
+
+// ======================== save ========================
+// 从连续内存写出 文件头后直接整块顺序写入
+template <class T, size_t Rank>
+void save_npy(const std::string& path, const T* data, const std::array<size_t, Rank>& extents, bool fortran_order) {
+  npy_file fp = npy_open(path, "wb");
+  const std::string header = make_npy_header(npy_dtype<T>::descr, fortran_order, extents.data(), Rank);
+  npy_write_all(fp.get(), header.data(), header.size());
+
+  size_t n = 1;
+  for (auto s : extents) {
+    n *= s;
+  }
+  npy_write_all(fp.get(), data, n * sizeof(T));
+}
+
+template <class T, size_t Rank, class Layout>
+void save_npy(const std::string& path, const mdvector<T, Rank, Layout>& vec) {
+  save_npy<T, Rank>(path, vec.begin(), vec.extents(), npy_fortran_order<Layout>());
+}
+
+template <class T, size_t Rank, class Layout>
+void save_npy(const std::string& path, const span<T, Rank, Layout>& view) {
+  save_npy<T, Rank>(path, view.begin(), view.extents(), npy_fortran_order<Layout>());
+}
+
+template <class T, class Layout, size_t... lengths>
+void save_npy(const std::string& path, const mdarray_base<T, Layout, void, lengths...>& arr) {
+  save_npy<T, sizeof...(lengths)>(path, arr.begin(), arr.extents(), npy_fortran_order<Layout>());
+}
+
+// ======================== load ========================
+// 读入已有mdvector 形状不同时重置形状(不初始化 随后整体覆盖) 数据一次性读入simd对齐内存
+template <class T, size_t Rank, class Layout>
+void load_npy(const std::string& path, mdvector<T, Rank, Layout>& vec) {
+  npy_file fp = npy_open(path, "rb");
+  const npy_header header = read_npy_header(fp.get());
+  const auto extents = check_npy_header<T, Rank, Layout>(header);
+  if (vec.extents() != extents) {
+    vec.reset_shape(extents, uninitialized);
+  }
+  npy_read_all(fp.get(), vec.begin(), header.total_size() * sizeof(T));
+}
+
+template <class T, size_t Rank, class Layout = layout_right>
+mdvector<T, Rank, Layout> load_npy(const std::string& path) {
+  mdvector<T, Rank, Layout> res;
+  load_npy(path, res);
+  return res;
+}
+
+template <class T, class Layout, size_t... lengths>
+void load_npy(const std::string& path, mdarray_base<T, Layout, void, lengths...>& arr) {
+  npy_file fp = npy_open(path, "rb");
+  const npy_header header = read_npy_header(fp.get());
+  const auto extents = check_npy_header<T, sizeof...(lengths), Layout>(header);
+  if (arr.extents() != extents) {
+    throw std::runtime_error("npy: shape mismatch for mdarray");
+  }
+  npy_read_all(fp.get(), arr.begin(), header.total_size() * sizeof(T));
+}
+
+// ======================== mmap ========================
+enum class npy_map_mode {
+  copy_on_write,  // 写时复制 修改不会写回文件
+  read_write,     // 共享映射 修改直接写回文件
+};
+
+// 内存映射 数据区满足simd对齐时零拷贝 否则一次性读入对齐内存
+// read_write模式必须零拷贝 无法映射时抛出异常
+template <class T, size_t Rank, class Layout = layout_right>
+class mapped_npy {
+ public:
+  explicit mapped_npy(const std::string& path, npy_map_mode mode = npy_map_mode::copy_on_write) {
+    npy_header header;
+    {
+      npy_file fp = npy_open(path, "rb");
+      header = read_npy_header(fp.get());
+    }
+    extents_ = check_npy_header<T, Rank, Layout>(header);
+    size_ = header.total_size();
+
+    // 数据区不完整时与load_npy一样抛出异常 避免映射后越过文件末尾访问触发SIGBUS
+    const size_t required = header.data_offset + size_ * sizeof(T);
+    if (header.data_offset % simd_alignment() == 0 && map_file(path, mode, required)) {
+      data_ = reinterpret_cast<T*>(static_cast<char*>(base_) + header.data_offset);
+    } else if (mode == npy_map_mode::read_write) {
+      throw std::runtime_error("npy: cannot map " + path + " for writing");
+    } else {
+      load_npy(path, fallback_);
+      data_ = fallback_.begin();
+    }
+  }
+
+  ~mapped_npy() { unmap(); }
+
+  mapped_npy(const mapped_npy&) = delete;
+  mapped_npy& operator=(const mapped_npy&) = delete;
+
+  mapped_npy(mapped_npy&& other) noexcept { swap(other); }
+
+  mapped_npy& operator=(mapped_npy&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // 是否直接映射文件(零拷贝)
+  bool zero_copy() const noexcept { return base_ != nullptr; }
+
+  T* data() noexcept { return data_; }
+
+  const T* data() const noexcept { return data_; }
+
+  size_t size() const noexcept { return size_; }
+
+  std::array<size_t, Rank> extents() const noexcept { return extents_; }
+
+  md::span<T, Rank, Layout> span() noexcept { return md::span<T, Rank, Layout>(data_, extents_); }
+
+ private:
+  static constexpr size_t simd_alignment() {
+    if constexpr (std::is_floating_point_v<T>) {
+      return simd<T>::alignment;
+    } else {
+      return alignof(T);
+    }
+  }
+
+  bool map_file(const std::string& path, npy_map_mode mode, size_t required) {
+    const bool shared = mode == npy_map_mode::read_write;
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), shared ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      file_ = nullptr;
+      return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_, &file_size)) {
+      unmap();
+      return false;
+    }
+    if (static_cast<uint64_t>(file_size.QuadPart) < required) {
+      unmap();
+      throw std::runtime_error("npy: unexpected end of file");
+    }
+    mapping_ = CreateFileMappingA(file_, nullptr, shared ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping_ != nullptr) {
+      base_ = MapViewOfFile(mapping_, shared ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, 0);
+    }
+    if (base_ == nullptr) {
+      unmap();
+      return false;
+    }
+    return true;
+#else
+    const int fd = ::open(path.c_str(), shared ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      return false;
+    }
+    if (static_cast<uint64_t>(st.st_size) < required) {
+      ::close(fd);
+      throw std::runtime_error("npy: unexpected end of file");
+    }
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, shared ? MAP_SHARED : MAP_PRIVATE,
+                     fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      return false;
+    }
+    base_ = p;
+    mapped_bytes_ = static_cast<size_t>(st.st_size);
+    return true;
+#endif
+  }
+
+  void unmap() noexcept {
+#ifdef _WIN32
+    if (base_ != nullptr) UnmapViewOfFile(base_);
+    if (mapping_ != nullptr) CloseHandle(mapping_);
+    if (file_ != nullptr) CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (base_ != nullptr) ::munmap(base_, mapped_bytes_);
+#endif
+    base_ = nullptr;
+    mapped_bytes_ = 0;
+  }
+
+  void swap(mapped_npy& other) noexcept {
+    std::swap(base_, other.base_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+#ifdef _WIN32
+    std::swap(file_, other.file_);
+    std::swap(mapping_, other.mapping_);
+#endif
+    std::swap(size_, other.size_);
+    std::swap(extents_, other.extents_);
+    std::swap(fallback_, other.fallback_);
+    std::swap(data_, other.data_);
+    // 小数组保存在mdvector对象内部 交换后地址改变 未映射的一方按fallback_重新取数据指针
+    if (base_ == nullptr) data_ = fallback_.begin();
+    if (other.base_ == nullptr) other.data_ = other.fallback_.begin();
+  }
+
+  void* base_ = nullptr;
+  size_t mapped_bytes_ = 0;
+#ifdef _WIN32
+  HANDLE file_ = nullptr;
+  HANDLE mapping_ = nullptr;
+#endif
+  T* data_ = nullptr;
+  size_t size_ = 0;
+  std::array<size_t, Rank> extents_{};
+  mdvector<T, Rank, Layout> fallback_;
+};
+
+template <class T, size_t Rank, class Layout = layout_right>
+mapped_npy<T, Rank, Layout> map_npy(const std::string& path, npy_map_mode mode = npy_map_mode::copy_on_write) {
+  return mapped_npy<T, Rank, Layout>(path, mode);
+}
+
+// 创建指定形状的npy文件(数据区为稀疏空洞 不实际写入)并以read_write模式映射
+template <class T, size_t Rank, class Layout = layout_right>
+mapped_npy<T, Rank, Layout> create_npy(const std::string& path, const std::array<size_t, Rank>& extents) {
+  {
+    npy_file fp = npy_open(path, "wb");
+    const std::string header =
+        make_npy_header(npy_dtype<T>::descr, npy_fortran_order<Layout>(), extents.data(), Rank);
+    npy_write_all(fp.get(), header.data(), header.size());
+
+    size_t n = 1;
+    for (auto s : extents) {
+      n *= s;
+    }
+    if (n > 0) {
+      const uint64_t last = header.size() + n * sizeof(T) - 1;
+#ifdef _WIN32
+      const int ret = _fseeki64(fp.get(), static_cast<long long>(last), SEEK_SET);
+#else
+      const int ret = fseeko(fp.get(), static_cast<off_t>(last), SEEK_SET);
+#endif
+      if (ret != 0 || std::fputc(0, fp.get()) == EOF) {
+        throw std::runtime_error("npy: cannot extend file " + path);
+      }
+    }
+  }
+  return mapped_npy<T, Rank, Layout>(path, npy_map_mode::read_write);
+}
+
+// ======================== npz ========================
+// 不压缩的zip归档(stored) 与numpy.savez/numpy.load兼容
+inline uint32_t crc32_update(uint32_t crc, const void* data, size_t bytes) {
+  static const auto table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < bytes; ++i) {
+    crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+inline void npz_put16(std::string& buf, uint32_t v) {
+  buf += static_cast<char>(v & 0xff);
+  buf += static_cast<char>((v >> 8) & 0xff);
+}
+
+inline void npz_put32(std::string& buf, uint32_t v) {
+  npz_put16(buf, v & 0xffff);
+  npz_put16(buf, v >> 16);
+}
+
+inline uint32_t npz_get16(const unsigned char* p) { return p[0] | (uint32_t(p[1]) << 8); }
+
+inline uint32_t npz_get32(const unsigned char* p) { return npz_get16(p) | (npz_get16(p + 2) << 16); }
+
+inline uint64_t npz_get64(const unsigned char* p) { return npz_get32(p) | (uint64_t(npz_get32(p + 4)) << 32); }
+
+class npz_writer {
+ public:
+  explicit npz_writer(const std::string& path) : fp_(npy_open(path, "wb")) {}
+
+  ~npz_writer() {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  npz_writer(const npz_writer&) = delete;
+  npz_writer& operator=(const npz_writer&) = delete;
+
+  template <class T, size_t Rank, class Layout>
+  void add(const std::string& name, const mdvector<T, Rank, Layout>& vec) {
+    add<T, Rank>(name, vec.begin(), vec.extents(), npy_fortran_order<Layout>());
+  }
+
+  template <class T, class Layout, size_t... lengths>
+  void add(const std::string& name, const mdarray_base<T, Layout, void, lengths...>& arr) {
+    add<T, sizeof...(lengths)>(name, arr.begin(), arr.extents(), npy_fortran_order<Layout>());
+  }
+
+  template <class T, size_t Rank>
+  void add(const std::string& name, const T* data, const std::array<size_t, Rank>& extents, bool fortran_order) {
+    size_t n = 1;
+    for (auto s : extents) {
+      n *= s;
+    }
+    const std::string header = make_npy_header(npy_dtype<T>::descr, fortran_order, extents.data(), Rank);
+    add_entry(name + ".npy", header, data, n * sizeof(T));
+  }
+
+  // 写出中央目录 之后不可再添加
+  void close() {
+    if (!fp_) return;
+
+    std::string dir;
+    for (const auto& e : entries_) {
+      npz_put32(dir, 0x02014b50);
+      npz_put16(dir, 20);  // version made by
+      npz_put16(dir, 20);  // version needed
+      npz_put16(dir, 0);   // flags
+      npz_put16(dir, 0);   // stored
+      npz_put16(dir, 0);   // time
+      npz_put16(dir, 0x21);  // date 1980-01-01
+      npz_put32(dir, e.crc);
+      npz_put32(dir, e.size);
+      npz_put32(dir, e.size);
+      npz_put16(dir, static_cast<uint32_t>(e.name.size()));
+      npz_put16(dir, 0);  // extra
+      npz_put16(dir, 0);  // comment
+      npz_put16(dir, 0);  // disk
+      npz_put16(dir, 0);  // internal attr
+      npz_put32(dir, 0);  // external attr
+      npz_put32(dir, e.offset);
+      dir += e.name;
+    }
+
+    std::string end;
+    npz_put32(end, 0x06054b50);
+    npz_put16(end, 0);
+    npz_put16(end, 0);
+    npz_put16(end, static_cast<uint32_t>(entries_.size()));
+    npz_put16(end, static_cast<uint32_t>(entries_.size()));
+    npz_put32(end, static_cast<uint32_t>(dir.size()));
+    npz_put32(end, static_cast<uint32_t>(offset_));
+    npz_put16(end, 0);
+
+    npy_write_all(fp_.get(), dir.data(), dir.size());
+    npy_write_all(fp_.get(), end.data(), end.size());
+    fp_.reset();
+  }
+
+ private:
+  struct entry {
+    std::string name;
+    uint32_t crc;
+    uint32_t size;
+    uint32_t offset;
+  };
+
+  void add_entry(const std::string& name, const std::string& header, const void* data, size_t bytes) {
+    if (!fp_) {
+      throw std::runtime_error("npz: writer already closed");
+    }
+    const size_t total = header.size() + bytes;
+    if (total >= 0xffffffffu || offset_ + total + name.size() + 30 >= 0xffffffffu) {
+      throw std::runtime_error("npz: archives larger than 4GB are not supported, use save_npy");
+    }
+
+    entry e;
+    e.name = name;
+    e.crc = crc32_update(crc32_update(0, header.data(), header.size()), data, bytes);
+    e.size = static_cast<uint32_t>(total);
+    e.offset = static_cast<uint32_t>(offset_);
+
+    std::string local;
+    npz_put32(local, 0x04034b50);
+    npz_put16(local, 20);
+    npz_put16(local, 0);
+    npz_put16(local, 0);
+    npz_put16(local, 0);
+    npz_put16(local, 0x21);
+    npz_put32(local, e.crc);
+    npz_put32(local, e.size);
+    npz_put32(local, e.size);
+    npz_put16(local, static_cast<uint32_t>(name.size()));
+    npz_put16(local, 0);
+    local += name;
+
+    npy_write_all(fp_.get(), local.data(), local.size());
+    npy_write_all(fp_.get(), header.data(), header.size());
+    npy_write_all(fp_.get(), data, bytes);
+
+    offset_ += local.size() + total;
+    entries_.push_back(std::move(e));
+  }
+
+  npy_file fp_;
+  size_t offset_ = 0;
+  std::vector<entry> entries_;
+};
+
+class npz_reader {
+ public:
+  explicit npz_reader(const std::string& path) : fp_(npy_open(path, "rb")) { read_directory(); }
+
+  std::vector<std::string> names() const {
+    std::vector<std::string> res;
+    for (const auto& e : entries_) {
+      res.push_back(e.name);
+    }
+    return res;
+  }
+
+  template <class T, size_t Rank, class Layout>
+  void load(const std::string& name, mdvector<T, Rank, Layout>& vec) {
+    const npy_header header = seek_entry(name);
+    const auto extents = check_npy_header<T, Rank, Layout>(header);
+    if (vec.extents() != extents) {
+      vec.reset_shape(extents, uninitialized);
+    }
+    npy_read_all(fp_.get(), vec.begin(), header.total_size() * sizeof(T));
+  }
+
+  template <class T, size_t Rank, class Layout = layout_right>
+  mdvector<T, Rank, Layout> load(const std::string& name) {
+    mdvector<T, Rank, Layout> res;
+    load(name, res);
+    return res;
+  }
+
+  template <class T, class Layout, size_t... lengths>
+  void load(const std::string& name, mdarray_base<T, Layout, void, lengths...>& arr) {
+    const npy_header header = seek_entry(name);
+    const auto extents = check_npy_header<T, sizeof...(lengths), Layout>(header);
+    if (arr.extents() != extents) {
+      throw std::runtime_error("npz: shape mismatch for mdarray");
+    }
+    npy_read_all(fp_.get(), arr.begin(), header.total_size() * sizeof(T));
+  }
+
+ private:
+  struct entry {
+    std::string name;  // 不含.npy后缀
+    uint64_t local_offset;
+  };
+
+  void seek(uint64_t pos) {
+#ifdef _WIN32
+    const int ret = _fseeki64(fp_.get(), static_cast<long long>(pos), SEEK_SET);
+#else
+    const int ret = fseeko(fp_.get(), static_cast<off_t>(pos), SEEK_SET);
+#endif
+    if (ret != 0) {
+      throw std::runtime_error("npz: seek failed");
+    }
+  }
+
+  void read_directory() {
+    std::fseek(fp_.get(), 0, SEEK_END);
+    const long file_size = std::ftell(fp_.get());
+    // 结束记录22字节 + 最长65535字节注释
+    const long tail = file_size < 65557 ? file_size : 65557;
+    std::vector<unsigned char> buf(static_cast<size_t>(tail));
+    seek(static_cast<uint64_t>(file_size - tail));
+    npy_read_all(fp_.get(), buf.data(), buf.size());
+
+    long pos = tail - 22;
+    while (pos >= 0 && npz_get32(&buf[pos]) != 0x06054b50) {
+      --pos;
+    }
+    if (pos < 0) {
+      throw std::runtime_error("npz: end of central directory not found");
+    }
+    const uint32_t count = npz_get16(&buf[pos + 10]);
+    const uint32_t dir_size = npz_get32(&buf[pos + 12]);
+    const uint32_t dir_offset = npz_get32(&buf[pos + 16]);
+
+    std::vector<unsigned char> dir(dir_size);
+    seek(dir_offset);
+    npy_read_all(fp_.get(), dir.data(), dir.size());
+
+    size_t p = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      if (p + 46 > dir.size() || npz_get32(&dir[p]) != 0x02014b50) {
+        throw std::runtime_error("npz: malformed central directory");
+      }
+      if (npz_get16(&dir[p + 10]) != 0) {
+        throw std::runtime_error("npz: compressed archives are not supported");
+      }
+      const uint32_t name_len = npz_get16(&dir[p + 28]);
+      const uint32_t extra_len = npz_get16(&dir[p + 30]);
+      const uint32_t comment_len = npz_get16(&dir[p + 32]);
+      uint64_t local_offset = npz_get32(&dir[p + 42]);
+      std::string name(reinterpret_cast<const char*>(&dir[p + 46]), name_len);
+
+      // zip64扩展字段 按size/compressed size/offset顺序仅记录溢出项
+      if (local_offset == 0xffffffffu) {
+        const unsigned char* extra = &dir[p + 46 + name_len];
+        for (uint32_t e = 0; e + 4 <= extra_len;) {
+          const uint32_t id = npz_get16(extra + e);
+          const uint32_t len = npz_get16(extra + e + 2);
+          if (id == 0x0001) {
+            uint32_t k = 0;
+            if (npz_get32(&dir[p + 24]) == 0xffffffffu) k += 8;
+            if (npz_get32(&dir[p + 20]) == 0xffffffffu) k += 8;
+            local_offset = npz_get64(extra + e + 4 + k);
+          }
+          e += 4 + len;
+        }
+      }
+
+      if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0) {
+        name.resize(name.size() - 4);
+      }
+      entries_.push_back(entry{name, local_offset});
+      p += 46 + name_len + extra_len + comment_len;
+    }
+  }
+
+  // 定位到条目的npy数据区并返回其文件头
+  npy_header seek_entry(const std::string& name) {
+    for (const auto& e : entries_) {
+      if (e.name != name) continue;
+
+      unsigned char local[30];
+      seek(e.local_offset);
+      npy_read_all(fp_.get(), local, 30);
+      if (npz_get32(local) != 0x04034b50) {
+        throw std::runtime_error("npz: malformed local header");
+      }
+      seek(e.local_offset + 30 + npz_get16(local + 26) + npz_get16(local + 28));
+      return read_npy_header(fp_.get());
+    }
+    throw std::runtime_error("npz: no array named " + name);
+  }
+
+  npy_file fp_;
+  std::vector<entry> entries_;
+};
+
+template <class T, size_t Rank, class Layout = layout_right>
+mdvector<T, Rank, Layout> load_npz(const std::string& path, const std::string& name) {
+  return npz_reader(path).load<T, Rank, Layout>(name);
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_NPY_H__
@@ -0,0 +1,175 @@
+#ifndef __MDVECTOR_OUT_OF_CORE_H__
+#define __MDVECTOR_OUT_OF_CORE_H__
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "io/npy.h"
+
+namespace md {
+
+struct out_of_core_options {
+  size_t chunk_bytes = size_t(64) << 20;  // 每块输出的字节数 会向下取整到页大小
+  size_t page_bytes = 4096;               // 预取时每页只触碰一个字节
+  bool flush_output = true;               // 每块计算完成后异步回写输出 保持顺序写盘
+};
+
+// 后台预取线程 把输入区间的页提前读入内存 与当前块的计算重叠
+class chunk_prefetcher {
+ public:
+  chunk_prefetcher(std::vector<std::pair<const char*, size_t>> inputs, size_t page_bytes)
+      : inputs_(std::move(inputs)), page_bytes_(page_bytes), worker_([this] { run(); }) {}
+
+  ~chunk_prefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  chunk_prefetcher(const chunk_prefetcher&) = delete;
+  chunk_prefetcher& operator=(const chunk_prefetcher&) = delete;
+
+  // 请求预取[begin, end)字节区间(相对每个输入的起点)
+  void request(size_t begin, size_t end) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      begin_ = begin;
+      end_ = end;
+      ++requested_;
+    }
+    cv_.notify_all();
+  }
+
+  // 等待最近一次请求完成
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return finished_ == requested_; });
+  }
+
+ private:
+  void run() {
+    size_t handled = 0;
+    for (;;) {
+      size_t begin, end;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return stop_ || requested_ != handled; });
+        if (stop_) return;
+        begin = begin_;
+        end = end_;
+        handled = requested_;
+      }
+
+      for (const auto& in : inputs_) {
+        if (begin >= in.second) continue;
+        touch(in.first + begin, (end < in.second ? end : in.second) - begin);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = handled;
+      }
+      cv_.notify_all();
+    }
+  }
+
+  void touch(const char* p, size_t bytes) {
+#ifndef _WIN32
+    // 先提交异步预读 再逐页触碰保证缺页在本线程完成
+    const uintptr_t page_mask = ~(uintptr_t(page_bytes_) - 1);
+    char* page_begin = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(p) & page_mask);
+    ::madvise(page_begin, static_cast<size_t>(p + bytes - page_begin), MADV_WILLNEED);
+#endif
+    char sink = 0;
+    for (size_t off = 0; off < bytes; off += page_bytes_) {
+      sink ^= static_cast<const volatile char*>(p)[off];
+    }
+    if (bytes > 0) {
+      sink ^= static_cast<const volatile char*>(p)[bytes - 1];
+    }
+    sink_ ^= sink;
+  }
+
+  std::vector<std::pair<const char*, size_t>> inputs_;
+  size_t page_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  size_t requested_ = 0;
+  size_t finished_ = 0;
+  bool stop_ = false;
+  volatile char sink_ = 0;
+
+  std::thread worker_;
+};
+
+// 分块计算表达式 后台线程预取下一块输入 当前块计算完成后顺序回写
+// 要求所有非标量操作数与dest长度相同(即可以逐元素对应)
+template <class T, class E>
+void eval_out_of_core(T* dest, const tensor_expr<E, T>& expr, const out_of_core_options& options = {}) {
+  const size_t n = expr.used_size();
+  if (n == 0) return;
+
+  std::vector<std::pair<const char*, size_t>> inputs;
+  expr.derived().visit_data([&inputs, n](const T* data, size_t size) {
+    if (size >= n) {
+      inputs.emplace_back(reinterpret_cast<const char*>(data), n * sizeof(T));
+    }
+  });
+
+  // 块大小取页与simd包长的整数倍
+  const size_t page_elems = options.page_bytes / sizeof(T) > 0 ? options.page_bytes / sizeof(T) : 1;
+  size_t chunk = options.chunk_bytes / sizeof(T) / page_elems * page_elems;
+  if (chunk < page_elems) chunk = page_elems;
+  chunk = (chunk + simd<T>::pack_size - 1) / simd<T>::pack_size * simd<T>::pack_size;
+
+  const bool aligned = is_simd_aligned(dest);
+
+  chunk_prefetcher prefetcher(std::move(inputs), options.page_bytes);
+  prefetcher.request(0, (chunk < n ? chunk : n) * sizeof(T));
+
+  for (size_t begin = 0; begin < n; begin += chunk) {
+    const size_t end = begin + chunk < n ? begin + chunk : n;
+
+    prefetcher.wait();
+    if (end < n) {
+      const size_t next_end = end + chunk < n ? end + chunk : n;
+      prefetcher.request(end * sizeof(T), next_end * sizeof(T));
+    }
+
+    if (aligned) {
+      expr.template eval_to_range<T, aligned_policy>(dest, begin, end);
+    } else {
+      expr.template eval_to_range<T, unaligned_policy>(dest, begin, end);
+    }
+
+#ifndef _WIN32
+    if (options.flush_output) {
+      const uintptr_t page_mask = ~(uintptr_t(options.page_bytes) - 1);
+      char* p = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(dest + begin) & page_mask);
+      ::msync(p, static_cast<size_t>(reinterpret_cast<char*>(dest + end) - p), MS_ASYNC);
+    }
+#endif
+  }
+}
+
+template <class T, size_t Rank, class Layout, class E>
+void eval_out_of_core(mapped_npy<T, Rank, Layout>& dest, const tensor_expr<E, T>& expr,
+                      const out_of_core_options& options = {}) {
+  if (dest.size() != expr.used_size()) {
+    throw std::runtime_error("out of core: destination size does not match expression");
+  }
+  eval_out_of_core(dest.data(), expr, options);
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_OUT_OF_CORE_H__
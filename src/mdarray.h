@@ -2,7 +2,9 @@
 #define __MDARRAY_H__
 
 #include <algorithm>
+#include <cmath>
 
+#include "expression_template/static_eval.h"
 #include "multi_dimension/engine_static.h"
 
 template <class T, class Layout, class Enable, size_t... lengths>
@@ -70,6 +72,9 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
   using Policy = md::unaligned_policy;
 
  public:
+  // 补齐后的长度 供static_padded_size识别定长操作数
+  static constexpr size_t padded_size = Impl::total_size;
+
   using Impl::Impl;
 
   mdarray_base(const mdarray_base& other) : Impl(other) {}
@@ -99,6 +104,7 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
   using Impl::shapes;
   using Impl::size;
   using Impl::used_size;
+  using Impl::view;
 
   using iterator = T*;
   using const_iterator = const T*;
@@ -116,10 +122,15 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
 
   template <class E>
   mdarray_base& operator=(const md::tensor_expr<E, T>& expr) {
-    expr.eval_to<T, Policy>(this->data());
+    assign(expr.derived());
     return *this;
   }
 
+  template <class F>
+  void visit_data(F&& f) const {
+    f(this->data(), this->used_size());
+  }
+
   template <class T2>
   typename md::simd<T2>::type eval_simd(size_t i) const {
     return md::simd<T2>::load(this->data() + i);
@@ -131,46 +142,46 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
   }
 
   mdarray_base& operator+=(const mdarray_base& other) {
-    md::simd_add_inplace<T, Policy>(this->data(), other.data(), this->size());
+    assign(*this + other);
     return *this;
   }
 
   mdarray_base& operator-=(const mdarray_base& other) {
-    md::simd_sub_inplace<T, Policy>(this->data(), other.data(), this->size());
+    assign(*this - other);
     return *this;
   }
 
   mdarray_base& operator*=(const mdarray_base& other) {
-    md::simd_mul_inplace<T, Policy>(this->data(), other.data(), this->size());
+    assign(*this * other);
     return *this;
   }
 
   mdarray_base& operator/=(const mdarray_base& other) {
-    md::simd_div_inplace<T, Policy>(this->data(), other.data(), this->size());
+    assign(*this / other);
     return *this;
   }
 
   template <class E>
   mdarray_base& operator+=(const md::tensor_expr<E, T>& expr) {
-    (*this + expr).eval_to<T, Policy>(this->data());
+    assign(*this + expr);
     return *this;
   }
 
   template <class E>
   mdarray_base& operator-=(const md::tensor_expr<E, T>& expr) {
-    (*this - expr).eval_to<T, Policy>(this->data());
+    assign(*this - expr);
     return *this;
   }
 
   template <class E>
   mdarray_base& operator*=(const md::tensor_expr<E, T>& expr) {
-    (*this * expr).eval_to<T, Policy>(this->data());
+    assign(*this * expr);
     return *this;
   }
 
   template <class E>
   mdarray_base& operator/=(const md::tensor_expr<E, T>& expr) {
-    (*this / expr).eval_to<T, Policy>(this->data());
+    assign(*this / expr);
     return *this;
   }
 
@@ -204,7 +215,7 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
   void show_data_matrix_style() {
     if (sizeof...(lengths) == 0) return;
 
-    const size_t cols = this->view_.extent(sizeof...(lengths) - 1);
+    const size_t cols = this->extent(sizeof...(lengths) - 1);
     const size_t rows = used_size() / cols;
 
     for (size_t i = 0; i < rows; ++i) {
@@ -256,6 +267,17 @@ class mdarray_base<T, Layout, std::enable_if_t<std::is_floating_point_v<T>>, len
                    [y](T val) noexcept { return std::pow(val, y); });
     return res;
   }
+
+ private:
+  // 所有操作数均为同尺寸mdarray(或标量)时使用编译期展开的对齐计算
+  template <class E>
+  void assign(const E& expr) noexcept {
+    if constexpr (md::is_padded_expr_v<E, padded_size>) {
+      md::eval_static<padded_size>(this->data(), expr);
+    } else {
+      expr.template eval_to<T, Policy>(this->data());
+    }
+  }
 };
 
 #define DEFINE_MDARRAY_MATH_FUNC(name)                                       \
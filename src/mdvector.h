@@ -32,13 +32,18 @@ class mdvector : private md::engine_dynamic<T, Rank, Layout> {
   using Impl::operator[];
 #endif
   using Impl::at;
+  using Impl::capacity;
   using Impl::extent;
   using Impl::extents;
+  using Impl::is_adopted;
+  using Impl::reserve;
   using Impl::reset_shape;
   using Impl::set_value;
   using Impl::shapes;
+  using Impl::shrink_to_fit;
   using Impl::size;
   using Impl::used_size;
+  using Impl::view;
 
   using iterator = T*;
   using const_iterator = const T*;
@@ -58,7 +63,7 @@ class mdvector : private md::engine_dynamic<T, Rank, Layout> {
 // double/float with simd_ET
 template <class T, size_t Rank, class Layout>
 class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
-    : public md::tensor_expr<mdvector<T, Rank>, T>, private md::engine_dynamic<T, Rank, Layout> {
+    : public md::tensor_expr<mdvector<T, Rank, Layout>, T>, private md::engine_dynamic<T, Rank, Layout> {
   using Impl = md::engine_dynamic<T, Rank, Layout>;
   using Policy = md::aligned_policy;
 
@@ -86,13 +91,18 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
   using Impl::operator[];
 #endif
   using Impl::at;
+  using Impl::capacity;
   using Impl::extent;
   using Impl::extents;
+  using Impl::is_adopted;
+  using Impl::reserve;
   using Impl::reset_shape;
   using Impl::set_value;
   using Impl::shapes;
+  using Impl::shrink_to_fit;
   using Impl::size;
   using Impl::used_size;
+  using Impl::view;
 
   using iterator = T*;
   using const_iterator = const T*;
@@ -110,10 +120,24 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
 
   template <class E>
   mdvector(const md::tensor_expr<E, T>& expr) noexcept {
-    this->reset_shape(expr.extents());
+    this->reset_shape(expr.extents(), md::uninitialized);
     expr.eval_to<T, Policy>(this->data());
   }
 
+  // 右值表达式中含有形状相同的右值mdvector时 在其内存上原地计算并接管 不再分配新内存
+  template <class E>
+  mdvector(md::tensor_expr<E, T>&& expr) noexcept {
+    if constexpr (md::is_calculation_expr_v<E>) {
+      if (mdvector* buffer = expr.derived().template reusable_buffer<mdvector>(expr.extents())) {
+        expr.template eval_to<T, Policy>(buffer->data());
+        Impl::operator=(std::move(*buffer));
+        return;
+      }
+    }
+    this->reset_shape(expr.extents(), md::uninitialized);
+    expr.template eval_to<T, Policy>(this->data());
+  }
+
   template <class E>
   mdvector& operator=(const md::tensor_expr<E, T>& expr) noexcept {
     expr.eval_to<T, Policy>(this->data());
@@ -122,7 +146,7 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
 
   // 从span创建
   mdvector(const md::span<T, Rank, Layout>& span) noexcept {
-    this->reset_shape(span.extents());
+    this->reset_shape(span.extents(), md::uninitialized);
     span.eval_to<T, Policy>(this->data());
   }
 
@@ -135,6 +159,7 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
   template <class... Slices>
   auto span(Slices... slices) {
     static_assert(sizeof...(Slices) == Rank, "Number of slices must match dimensionality");
+    static_assert(!md::is_tiled_layout_v<Layout>, "span slices are not supported for tiled layout");
 
     constexpr std::size_t NewRank = md::compressed_rank_v<Slices...>;
 
@@ -173,6 +198,11 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
     }
   }
 
+  template <class F>
+  void visit_data(F&& f) const noexcept {
+    f(this->data(), this->used_size());
+  }
+
   template <class T2>
   typename md::simd<T2>::type eval_simd(size_t i) const noexcept {
     return md::simd<T2>::load(this->data() + i);
@@ -271,11 +301,16 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
 
   using this_type = mdvector;
   // 数学函数简化定义
-#define DEFINE_MD_MATH_OP(name, op)                                                                       \
-  this_type name() const noexcept {                                                                       \
-    this_type res(*this);                                                                                 \
-    std::transform(this->begin(), this->end(), res.begin(), [](T val) noexcept { return std::op(val); }); \
-    return res;                                                                                           \
+  // 右值调用时原地计算
+#define DEFINE_MD_MATH_OP(name, op)                                                                         \
+  this_type name() const& noexcept {                                                                        \
+    this_type res(this->extents(), md::uninitialized);                                                      \
+    std::transform(this->begin(), this->end(), res.begin(), [](T val) noexcept { return std::op(val); });   \
+    return res;                                                                                             \
+  }                                                                                                         \
+  this_type name() && noexcept {                                                                            \
+    std::transform(this->begin(), this->end(), this->begin(), [](T val) noexcept { return std::op(val); }); \
+    return std::move(*this);                                                                                \
   }
   // 三角函数
   DEFINE_MD_MATH_OP(cos, cos);
@@ -296,20 +331,30 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
 
 #undef DEFINE_MD_MATH_OP
 
-  this_type exp(T y) const noexcept {
-    this_type res(*this);
+  this_type exp(T y) const& noexcept {
+    this_type res(this->extents(), md::uninitialized);
     std::transform(this->data_.begin(), this->data_.end(), res.data_.begin(),
                    [y](T val) noexcept { return std::pow(y, val); });
     return res;
   }
 
-  this_type pow(T y) const noexcept {
-    this_type res(*this);
+  this_type exp(T y) && noexcept {
+    std::transform(this->begin(), this->end(), this->begin(), [y](T val) noexcept { return std::pow(y, val); });
+    return std::move(*this);
+  }
+
+  this_type pow(T y) const& noexcept {
+    this_type res(this->extents(), md::uninitialized);
     std::transform(this->data_.begin(), this->data_.end(), res.data_.begin(),
                    [y](T val) noexcept { return std::pow(val, y); });
     return res;
   }
 
+  this_type pow(T y) && noexcept {
+    std::transform(this->begin(), this->end(), this->begin(), [y](T val) noexcept { return std::pow(val, y); });
+    return std::move(*this);
+  }
+
  private:
   // 计算数据指针偏移
   std::size_t calculate_offset(const std::array<md::slice, Rank>& slices, const std::array<bool, Rank>& is_integral) {
@@ -334,7 +379,7 @@ class mdvector<T, Rank, Layout, std::enable_if_t<std::is_floating_point_v<T>>>
 #define DEFINE_SPAN_MATH_FUNC(name, func)                                                                \
   template <class T, size_t Rank, class Layout>                                                          \
   mdvector<T, Rank, Layout> md::span<T, Rank, Layout>::name() const noexcept {                           \
-    mdvector<T, Rank, Layout> res(this->extents_);                                                       \
+    mdvector<T, Rank, Layout> res(this->extents_, md::uninitialized);                                    \
     std::transform(this->begin(), this->end(), res.begin(), [](T val) noexcept { return (func)(val); }); \
     return res;                                                                                          \
   }
@@ -357,15 +402,14 @@ DEFINE_SPAN_MATH_FUNC(ln, std::log);
 
 template <class T, size_t Rank, class Layout>
 mdvector<T, Rank, Layout> md::span<T, Rank, Layout>::exp(T y) const noexcept {
-  mdvector<T, Rank, Layout> res(this->extents_);
-  std::transform(this->data_.begin(), this->data_.end(), res.data_.begin(),
-                 [y](T val) noexcept { return std::pow(y, val); });
+  mdvector<T, Rank, Layout> res(this->extents_, md::uninitialized);
+  std::transform(this->begin(), this->end(), res.begin(), [y](T val) noexcept { return std::pow(y, val); });
   return res;
 }
 
 template <class T, size_t Rank, class Layout>
 mdvector<T, Rank, Layout> md::span<T, Rank, Layout>::pow(T y) const noexcept {
-  mdvector<T, Rank, Layout> res(this->extents_);
+  mdvector<T, Rank, Layout> res(this->extents_, md::uninitialized);
   std::transform(this->begin(), this->end(), res.begin(), [y](T val) noexcept { return std::pow(val, y); });
   return res;
 }
@@ -377,6 +421,10 @@ mdvector<T, Rank, Layout> md::span<T, Rank, Layout>::pow(T y) const noexcept {
     return v.name();                                       \
   }                                                        \
   template <class T, size_t Rank, class Layout>            \
+  auto name(mdvector<T, Rank, Layout>&& v) noexcept {      \
+    return std::move(v).name();                            \
+  }                                                        \
+  template <class T, size_t Rank, class Layout>            \
   auto name(const md::span<T, Rank, Layout>& v) noexcept { \
     return v.name();                                       \
   }
@@ -398,12 +446,19 @@ DEFINE_MD_MATH_FUNC(ln);
 #undef DEFINE_MD_MATH_FUNC
 
 // 从表达式创建mdvector 数学表达式的临时变量
+// 右值表达式可复用其中右值mdvector的内存
 #define DEFINE_EXPR_MATH_FUNC(name, func)                                                                 \
   template <class T, class E>                                                                             \
   mdvector<T, 1> name(const md::tensor_expr<E, T>& expr) noexcept {                                       \
     mdvector<T, 1> res = expr;                                                                            \
     std::transform(res.begin(), res.end(), res.begin(), [](double val) noexcept { return (func)(val); }); \
     return res;                                                                                           \
+  }                                                                                                       \
+  template <class T, class E>                                                                             \
+  mdvector<T, 1> name(md::tensor_expr<E, T>&& expr) noexcept {                                            \
+    mdvector<T, 1> res = std::move(expr);                                                                 \
+    std::transform(res.begin(), res.end(), res.begin(), [](double val) noexcept { return (func)(val); }); \
+    return res;                                                                                           \
   }
 
 DEFINE_EXPR_MATH_FUNC(cos, std::cos)
@@ -436,6 +491,12 @@ mdvector<T, 1> pow(const md::tensor_expr<E, T>& expr, T y) noexcept {
   return res;
 }
 
+// 右值mdvector作为操作数时移动进表达式树
+namespace md {
+template <class T, size_t Rank, class Layout>
+struct is_movable_operand<mdvector<T, Rank, Layout>> : std::is_floating_point<T> {};
+}  // namespace md
+
 // 常用别名
 using shape_1d = std::array<size_t, 1>;
 using shape_2d = std::array<size_t, 2>;
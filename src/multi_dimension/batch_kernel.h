@@ -0,0 +1,116 @@
+#ifndef __MDVECTOR_BATCH_KERNEL_H__
+#define __MDVECTOR_BATCH_KERNEL_H__
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "mdvector.h"
+
+namespace md {
+
+// 批量小对象运算(3维向量/四元数/小矩阵)的公共部分
+// 数据为SoA: 形状{N, n}的第c行为全部n个对象的第c个分量 simd每个通道对应一个对象
+namespace batch {
+
+template <class T>
+using pack_t = typename simd<T>::type;
+
+// 定长的一组simd包 按分量下标访问
+// 不用std::array<pack_t<T>, N>: __m256d等作为模板实参时GCC会给出-Wignored-attributes
+template <class T, size_t N>
+struct pack_array {
+  pack_t<T> v[N];
+
+  pack_t<T>& operator[](size_t i) noexcept { return v[i]; }
+  const pack_t<T>& operator[](size_t i) const noexcept { return v[i]; }
+
+  static constexpr size_t size() noexcept { return N; }
+};
+
+template <bool Full, class T>
+inline pack_t<T> load(const T* p, size_t remaining) {
+  if constexpr (Full) {
+    return simd<T>::loadu(p);
+  } else {
+    return simd<T>::mask_loadu(p, remaining);
+  }
+}
+
+template <bool Full, class T>
+inline void store(T* p, size_t remaining, const pack_t<T>& v) {
+  if constexpr (Full) {
+    simd<T>::storeu(p, v);
+  } else {
+    simd<T>::mask_storeu(p, remaining, v);
+  }
+}
+
+// 整包调用fn(std::true_type, i, pack_size) 尾部调用fn(std::false_type, i, remaining)
+template <class T, class F>
+void for_each_pack(size_t n, F&& fn) {
+  constexpr size_t P = simd<T>::pack_size;
+  size_t i = 0;
+  for (; i + P <= n; i += P) fn(std::true_type{}, i, P);
+  if (i < n) fn(std::false_type{}, i, n - i);
+}
+
+template <class F, size_t... I>
+inline void unroll_impl(F& fn, std::index_sequence<I...>) {
+  (fn(std::integral_constant<size_t, I>{}), ...);
+}
+
+// 编译期展开 依次调用fn(std::integral_constant<size_t, I>) I = 0..N-1
+template <size_t N, class F>
+inline void unroll(F&& fn) {
+  unroll_impl(fn, std::make_index_sequence<N>{});
+}
+
+// 按分量读入一个包 comp[c]为第c个分量
+template <bool Full, class T, size_t N>
+inline pack_array<T, N> load_components(const std::array<const T*, N>& rows, size_t i, size_t remaining) {
+  pack_array<T, N> comp;
+  for (size_t c = 0; c < N; ++c) comp[c] = load<Full>(rows[c] + i, remaining);
+  return comp;
+}
+
+// 各分量所在行 v的形状须为{N, *}
+template <size_t N, class T, size_t Rank>
+std::array<const T*, N> component_rows(const mdvector<T, Rank>& v, const char* who) {
+  static_assert(Rank >= 2, "batch operands must have rank >= 2");
+  size_t components = 1;
+  for (size_t r = 0; r + 1 < Rank; ++r) components *= v.extent(r);
+  if (components != N) {
+    throw std::invalid_argument(std::string(who) + ": operand has wrong number of components");
+  }
+  const size_t n = v.extent(Rank - 1);
+  std::array<const T*, N> rows;
+  for (size_t c = 0; c < N; ++c) rows[c] = v.begin() + c * n;
+  return rows;
+}
+
+template <class T, size_t RankA, size_t RankB>
+void check_count(const mdvector<T, RankA>& a, const mdvector<T, RankB>& b, const char* who) {
+  if (a.extent(RankA - 1) != b.extent(RankB - 1)) {
+    throw std::invalid_argument(std::string(who) + ": operands must have the same batch size");
+  }
+}
+
+// 输出形状不同时重置(不保留原有元素) 返回各分量所在行
+// 输出可以与输入为同一对象: 形状一致时不重新分配 且每个包先读后写
+template <size_t N, class T, size_t Rank>
+std::array<T*, N> output_rows(mdvector<T, Rank>& out, const std::array<size_t, Rank>& dims) {
+  if (out.extents() != dims) out.reset_shape(dims, md::discard);
+  const size_t n = dims[Rank - 1];
+  std::array<T*, N> rows;
+  for (size_t c = 0; c < N; ++c) rows[c] = out.begin() + c * n;
+  return rows;
+}
+
+}  // namespace batch
+
+}  // namespace md
+
+#endif  // __MDVECTOR_BATCH_KERNEL_H__
@@ -10,8 +10,57 @@ namespace md {
 struct layout_right {};
 struct layout_left {};
 
+// 分块布局(2维/3维): 按TR x TC (x TD)划分为块 块之间与块内部均为行优先 每块内存连续
+// 列方向或小窗口访问集中在少数缓存行/内存页上; 逐元素表达式仍为整体连续的simd遍历
+// 边缘不足整块时块按实际大小收缩 不补齐 元素总数与其他布局相同
+template <std::size_t TR, std::size_t TC, std::size_t TD = 1>
+struct layout_tiled {
+  static_assert(TR > 0 && TC > 0 && TD > 0, "tile extents must be positive");
+  static constexpr std::array<std::size_t, 3> tile{TR, TC, TD};
+};
+
+template <class Layout>
+struct is_tiled_layout : std::false_type {};
+
+template <std::size_t TR, std::size_t TC, std::size_t TD>
+struct is_tiled_layout<layout_tiled<TR, TC, TD>> : std::true_type {};
+
+template <class Layout>
+inline constexpr bool is_tiled_layout_v = is_tiled_layout<Layout>::value;
+
+// 构造标记: 只分配内存 不初始化元素
+struct uninitialized_t {
+  explicit uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+// 构造标记: 由线程池各线程并行置零 使内存页落在之后计算该段数据的线程所在的NUMA节点
+struct first_touch_t {
+  explicit first_touch_t() = default;
+};
+inline constexpr first_touch_t first_touch{};
+
+// reset_shape标记: 不保留原有元素 容量足够时直接复用内存
+struct discard_t {
+  explicit discard_t() = default;
+};
+inline constexpr discard_t discard{};
+
+// 构造标记: 接管调用方已分配的内存 不拷贝 析构时由调用方给出的deleter释放
+struct adopt_t {
+  explicit adopt_t() = default;
+};
+inline constexpr adopt_t adopt{};
+
+// 执行标记: 规模足够大时由线程池分段并行执行
+struct parallel_t {
+  explicit parallel_t() = default;
+};
+inline constexpr parallel_t parallel{};
+
 template <std::size_t Rank, class Layout = layout_right>
 auto compute_strides(const std::array<std::size_t, Rank>& extents) {
+  static_assert(!is_tiled_layout_v<Layout>, "tiled layout has no strides");
   std::array<std::size_t, Rank> strides;
   if constexpr (std::is_same_v<Layout, layout_right>) {
     strides.back() = 1;
@@ -37,6 +86,40 @@ constexpr std::size_t linear_index(const std::array<std::size_t, Rank>& strides,
   return idx;
 }
 
+// 分块布局的线性偏移
+// 第r维所在块之前的元素数 = 块起点 * (前r维块的实际大小之积) * (后面各维长度之积)
+template <class Layout, std::size_t Rank>
+constexpr std::size_t tiled_index(const std::array<std::size_t, Rank>& extents,
+                                  const std::array<std::size_t, Rank>& indices) {
+  static_assert(Rank == 2 || Rank == 3, "layout_tiled supports rank 2 and 3");
+  std::size_t offset = 0;
+  std::size_t local = 0;
+  std::size_t tile_size = 1;
+  for (std::size_t r = 0; r < Rank; ++r) {
+    const std::size_t t = Layout::tile[r];
+    const std::size_t start = indices[r] / t * t;
+    const std::size_t h = extents[r] - start < t ? extents[r] - start : t;
+    std::size_t outer = 1;
+    for (std::size_t k = r + 1; k < Rank; ++k) outer *= extents[k];
+    offset += start * tile_size * outer;
+    local = local * h + (indices[r] - start);
+    tile_size *= h;
+  }
+  return offset + local;
+}
+
+// 按布局计算线性偏移 步长布局为下标与步长的内积
+template <class Layout, std::size_t Rank>
+constexpr std::size_t linear_index(const std::array<std::size_t, Rank>& extents,
+                                   const std::array<std::size_t, Rank>& strides,
+                                   const std::array<std::size_t, Rank>& indices) {
+  if constexpr (is_tiled_layout_v<Layout>) {
+    return tiled_index<Layout>(extents, indices);
+  } else {
+    return linear_index(strides, indices);
+  }
+}
+
 // 闭区间
 struct slice {
   std::ptrdiff_t start;
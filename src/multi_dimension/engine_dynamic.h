@@ -8,17 +8,20 @@
 #include <vector>
 
 #include "expression_template/operator.h"
+#include "extents.h"
+#include "index_iterator.h"
 #include "mdspan.h"
 #include "simd/allocator.h"
 #include "simd/simd_function.h"
 #include "span.h"
+#include "storage.h"
 
 namespace md {
 
 template <class T, size_t Rank, class Layout = layout_right>
 class engine_dynamic {
  protected:
-  std::vector<T, auto_allocator<T>> data_;
+  dynamic_storage<T> data_;
   mdspan<T, Rank, Layout> mdspan_;
 
  public:
@@ -29,6 +32,27 @@ class engine_dynamic {
     static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
   }
 
+  // 不初始化元素 适用于随后会被整体覆盖的场景
+  engine_dynamic(const std::array<std::size_t, Rank>& dims, uninitialized_t)
+      : data_(calculate_size(dims), uninitialized), mdspan_(mdspan<T, Rank, Layout>(data_.data(), dims)) {
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
+  }
+
+  // 线程池按页并行置零 与parallel_assign使用相同划分
+  engine_dynamic(const std::array<std::size_t, Rank>& dims, first_touch_t)
+      : data_(calculate_size(dims), first_touch), mdspan_(mdspan<T, Rank, Layout>(data_.data(), dims)) {
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
+  }
+
+  // 接管调用方分配的内存 不拷贝 析构或重新分配时调用deleter(data)
+  // 浮点类型的计算按simd对齐读写 首地址未对齐时抛出异常 此时所有权仍归调用方 可改用md::span
+  template <class Deleter>
+  engine_dynamic(adopt_t, T* data, const std::array<std::size_t, Rank>& dims, Deleter deleter)
+      : data_(checked_adopt(data, calculate_size(dims)), calculate_size(dims), adopt, std::move(deleter)),
+        mdspan_(mdspan<T, Rank, Layout>(data_.data(), dims)) {
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
+  }
+
   ~engine_dynamic() = default;
 
   engine_dynamic(const engine_dynamic& other) : data_(other.data_), mdspan_(data_.data(), other.mdspan_.extents()) {}
@@ -39,7 +63,7 @@ class engine_dynamic {
   engine_dynamic& operator=(const engine_dynamic& other) {
     if (this != &other) {
       data_ = other.data_;
-      mdspan_ = mdspan<T, Rank>(data_.data(), other.mdspan_.extents());
+      mdspan_ = mdspan<T, Rank, Layout>(data_.data(), other.mdspan_.extents());
     }
     return *this;
   }
@@ -47,7 +71,7 @@ class engine_dynamic {
   engine_dynamic& operator=(engine_dynamic&& other) noexcept {
     if (this != &other) {
       data_ = std::move(other.data_);
-      mdspan_ = mdspan<T, Rank>(data_.data(), other.mdspan_.extents());
+      mdspan_ = mdspan<T, Rank, Layout>(data_.data(), other.mdspan_.extents());
     }
     return *this;
   }
@@ -89,6 +113,20 @@ class engine_dynamic {
     return mdspan_.get_1d_index(indices...);
   }
 
+  // 以静态/动态混合维度访问 E中md::dyn的维度取运行期长度 其余维度需与实际形状一致
+  // 例: vec.view<md::dyn, 3>() 第1维步长为编译期常量
+  template <size_t... E>
+  static_mdspan<T, md::extents<E...>, Layout> view() {
+    static_assert(sizeof...(E) == Rank, "Number of extents must match Rank");
+    return {data_.data(), md::extents<E...>(mdspan_.extents())};
+  }
+
+  template <size_t... E>
+  static_mdspan<const T, md::extents<E...>, Layout> view() const {
+    static_assert(sizeof...(E) == Rank, "Number of extents must match Rank");
+    return {data_.data(), md::extents<E...>(mdspan_.extents())};
+  }
+
   static size_t calculate_size(const std::array<std::size_t, Rank>& dims) {
     return std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<>());
   }
@@ -111,7 +149,35 @@ class engine_dynamic {
 
   void reset_shape(const std::array<std::size_t, Rank>& dims) {
     data_.resize(calculate_size(dims));
-    mdspan_ = mdspan<T, Rank>(data_.data(), dims);
+    mdspan_ = mdspan<T, Rank, Layout>(data_.data(), dims);
+  }
+
+  // 保留原有元素 新增元素不初始化
+  void reset_shape(const std::array<std::size_t, Rank>& dims, uninitialized_t) {
+    data_.resize(calculate_size(dims), uninitialized);
+    mdspan_ = mdspan<T, Rank, Layout>(data_.data(), dims);
+  }
+
+  // 不保留原有元素也不初始化 容量足够时不重新分配 用于形状频繁变化且随后整体覆盖的场景
+  void reset_shape(const std::array<std::size_t, Rank>& dims, discard_t) {
+    data_.resize(calculate_size(dims), discard);
+    mdspan_ = mdspan<T, Rank, Layout>(data_.data(), dims);
+  }
+
+  // 预留元素容量 不改变形状
+  void reserve(size_t n) {
+    data_.reserve(n);
+    mdspan_ = mdspan<T, Rank, Layout>(data_.data(), mdspan_.extents());
+  }
+
+  size_t capacity() const noexcept { return data_.capacity(); }
+
+  // 数据是否为接管的外部内存 超出容量的reserve/reset_shape会改为自行分配
+  bool is_adopted() const noexcept { return data_.is_adopted(); }
+
+  void shrink_to_fit() {
+    data_.shrink_to_fit();
+    mdspan_ = mdspan<T, Rank, Layout>(data_.data(), mdspan_.extents());
   }
 
   using iterator = T*;
@@ -131,6 +197,19 @@ class engine_dynamic {
   const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
   const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
   const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+ private:
+  static T* checked_adopt(T* data, size_t n) {
+    if (data == nullptr && n > 0) {
+      throw std::invalid_argument("adopted buffer is null");
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+      if (!is_simd_aligned(data)) {
+        throw std::invalid_argument("adopted buffer is not simd aligned, wrap it in md::span instead");
+      }
+    }
+    return data;
+  }
 };
 
 }  // namespace md
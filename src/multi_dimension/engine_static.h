@@ -7,6 +7,8 @@
 #include <string>
 
 #include "expression_template/operator.h"
+#include "extents.h"
+#include "index_iterator.h"
 #include "mdspan.h"
 #include "simd/simd_function.h"
 
@@ -19,35 +21,39 @@ class engine_static {
   static constexpr size_t total_size = (raw_total_size % simd<T>::pack_size == 0)
                                            ? raw_total_size
                                            : ((raw_total_size / simd<T>::pack_size) + 1) * simd<T>::pack_size;
+  using extents_type = md::extents<lengths...>;
+  using mapping_type = layout_mapping<extents_type, Layout>;
+
   alignas(simd<T>::alignment) std::array<T, total_size> data_;
-  mdspan<T, sizeof...(lengths), Layout> mdspan_;
+  // 全部为静态维度 步长均为编译期常量 下标计算只剩常数乘加
+  static constexpr mapping_type mapping_{};
 
  public:
-  explicit engine_static()
-      : mdspan_(mdspan<T, sizeof...(lengths), Layout>(
-            data_.data(), std::array<std::size_t, sizeof...(lengths)>{static_cast<std::size_t>(lengths)...})) {
+  explicit engine_static() {
     static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
     data_.fill(1.0);
   }
 
-  explicit engine_static(T val)
-      : mdspan_(mdspan<T, sizeof...(lengths), Layout>(
-            data_.data(), std::array<std::size_t, sizeof...(lengths)>{static_cast<std::size_t>(lengths)...})) {
+  explicit engine_static(T val) {
     static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
     data_.fill(val);
   }
 
+  // 不初始化元素 仅将补齐部分置零 避免补齐位置的随机值参与simd计算
+  explicit engine_static(uninitialized_t) {
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>, "T must be trivial and standard-layout!");
+    std::fill(data_.begin() + raw_total_size, data_.end(), T(0));
+  }
+
   ~engine_static() = default;
 
-  engine_static(const engine_static& other) : data_(other.data_), mdspan_(data_.data(), other.mdspan_.extents()) {}
+  engine_static(const engine_static& other) : data_(other.data_) {}
 
-  engine_static(engine_static&& other) noexcept
-      : data_(std::move(other.data_)), mdspan_(data_.data(), other.mdspan_.extents()) {}
+  engine_static(engine_static&& other) noexcept : data_(std::move(other.data_)) {}
 
   engine_static& operator=(const engine_static& other) {
     if (this != &other) {
       data_ = other.data_;
-      mdspan_ = mdspan<T, sizeof...(lengths), Layout>(data_.data(), other.mdspan_.extents());
     }
     return *this;
   }
@@ -55,48 +61,55 @@ class engine_static {
   engine_static& operator=(engine_static&& other) noexcept {
     if (this != &other) {
       data_ = std::move(other.data_);
-      mdspan_ = mdspan<T, sizeof...(lengths), Layout>(data_.data(), other.mdspan_.extents());
     }
     return *this;
   }
 
   template <class... Indices>
   T& operator()(Indices... indices) {
-    return mdspan_(indices...);
+    return data_[mapping_(indices...)];
   }
 
   template <class... Indices>
   const T& operator()(Indices... indices) const {
-    return mdspan_(indices...);
+    return data_[mapping_(indices...)];
   }
 
 #if defined(__cpp_multidimensional_subscript) || __cplusplus >= 202302L
   template <class... Indices>
   T& operator[](Indices... indices) {
-    return mdspan_(indices...);
+    return data_[mapping_(indices...)];
   }
 
   template <class... Indices>
   const T& operator[](Indices... indices) const {
-    return mdspan_(indices...);
+    return data_[mapping_(indices...)];
   }
 #endif
 
   template <class... Indices>
   T& at(Indices... indices) {
-    return mdspan_.at(indices...);
+    mapping_.check_bounds(indices...);
+    return data_[mapping_(indices...)];
   }
 
   template <class... Indices>
   const T& at(Indices... indices) const {
-    return mdspan_.at(indices...);
+    mapping_.check_bounds(indices...);
+    return data_[mapping_(indices...)];
   }
 
   template <class... Indices>
-  size_t& get_1d_index(Indices... indices) {
-    return mdspan_.get_1d_index(indices...);
+  size_t get_1d_index(Indices... indices) const {
+    mapping_.check_bounds(indices...);
+    return mapping_(indices...);
   }
 
+  // 静态维度视图
+  static_mdspan<T, extents_type, Layout> view() noexcept { return {data_.data(), extents_type()}; }
+
+  static_mdspan<const T, extents_type, Layout> view() const noexcept { return {data_.data(), extents_type()}; }
+
   static size_t calculate_size(const std::array<std::size_t, sizeof...(lengths)>& dims) {
     return std::accumulate(dims.begin(), dims.end(), 1, std::multiplies<>());
   }
@@ -109,11 +122,11 @@ class engine_static {
 
   size_t size() const { return raw_total_size; }
 
-  std::array<size_t, sizeof...(lengths)> shapes() const { return mdspan_.extents(); }
+  std::array<size_t, sizeof...(lengths)> shapes() const { return {lengths...}; }
 
-  std::array<size_t, sizeof...(lengths)> extents() const { return mdspan_.extents(); }
+  std::array<size_t, sizeof...(lengths)> extents() const { return {lengths...}; }
 
-  size_t extent(int i) const { return mdspan_.extents().at(i); }
+  size_t extent(int i) const { return extents().at(i); }
 
   void set_value(T val) { std::fill(data_.begin(), data_.end(), val); }
 
@@ -0,0 +1,240 @@
+#ifndef __MDVECTOR_EXTENTS_H__
+#define __MDVECTOR_EXTENTS_H__
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "detail.h"
+
+namespace md {
+
+// 运行期确定的维度
+inline constexpr size_t dyn = static_cast<size_t>(-1);
+
+// 静态/动态混合维度 只保存动态维度的长度
+// 例: extents<dyn, 3> 第0维运行期确定 第1维固定为3
+template <size_t... E>
+class extents {
+ public:
+  static constexpr size_t rank = sizeof...(E);
+  static constexpr size_t rank_dynamic = ((E == dyn ? 1 : 0) + ... + 0);
+  static constexpr std::array<size_t, rank> static_extents{E...};
+
+  constexpr extents() noexcept = default;
+
+  // 传入全部维度 静态维度必须一致
+  explicit extents(const std::array<size_t, rank>& all) {
+    size_t d = 0;
+    for (size_t r = 0; r < rank; ++r) {
+      if (static_extents[r] == dyn) {
+        dyn_[d++] = all[r];
+      } else if (static_extents[r] != all[r]) {
+        throw std::invalid_argument("extents: static extent does not match");
+      }
+    }
+  }
+
+  static constexpr size_t static_extent(size_t r) noexcept { return static_extents[r]; }
+
+  constexpr size_t extent(size_t r) const noexcept {
+    return static_extents[r] != dyn ? static_extents[r] : dyn_[dynamic_index(r)];
+  }
+
+  template <size_t R>
+  constexpr size_t extent() const noexcept {
+    if constexpr (static_extents[R] != dyn) {
+      return static_extents[R];
+    } else {
+      return dyn_[dynamic_index(R)];
+    }
+  }
+
+  constexpr size_t size() const noexcept {
+    size_t n = 1;
+    for (size_t r = 0; r < rank; ++r) {
+      n *= extent(r);
+    }
+    return n;
+  }
+
+  std::array<size_t, rank> to_array() const noexcept {
+    std::array<size_t, rank> res{};
+    for (size_t r = 0; r < rank; ++r) {
+      res[r] = extent(r);
+    }
+    return res;
+  }
+
+ private:
+  // 第r维在动态维度中的序号
+  static constexpr size_t dynamic_index(size_t r) noexcept {
+    size_t d = 0;
+    for (size_t k = 0; k < r; ++k) {
+      if (static_extents[k] == dyn) ++d;
+    }
+    return d;
+  }
+
+  std::array<size_t, rank_dynamic> dyn_{};
+};
+
+// 由维度与布局得到线性偏移 只依赖静态维度的步长在编译期确定
+// 全部为静态维度时偏移计算只剩常数乘加
+template <class Extents, class Layout = layout_right>
+class layout_mapping {
+ public:
+  static constexpr size_t rank = Extents::rank;
+
+  constexpr layout_mapping() noexcept = default;
+
+  explicit layout_mapping(const Extents& ext) noexcept : extents_(ext) {
+    for (size_t r = 0; r < rank; ++r) {
+      strides_[r] = 1;
+      if constexpr (std::is_same_v<Layout, layout_right>) {
+        for (size_t k = r + 1; k < rank; ++k) strides_[r] *= ext.extent(k);
+      } else {
+        for (size_t k = 0; k < r; ++k) strides_[r] *= ext.extent(k);
+      }
+    }
+  }
+
+  // 编译期步长 依赖动态维度时为dyn
+  template <size_t R>
+  static constexpr size_t static_stride() noexcept {
+    size_t s = 1;
+    constexpr size_t begin = std::is_same_v<Layout, layout_right> ? R + 1 : 0;
+    constexpr size_t end = std::is_same_v<Layout, layout_right> ? rank : R;
+    for (size_t k = begin; k < end; ++k) {
+      if (Extents::static_extents[k] == dyn) return dyn;
+      s *= Extents::static_extents[k];
+    }
+    return s;
+  }
+
+  template <size_t R>
+  constexpr size_t stride() const noexcept {
+    if constexpr (static_stride<R>() != dyn) {
+      return static_stride<R>();
+    } else {
+      return strides_[R];
+    }
+  }
+
+  template <class... Indices>
+  constexpr size_t operator()(Indices... indices) const noexcept {
+    static_assert(sizeof...(Indices) == rank, "Number of indices must match Rank");
+    return offset(std::make_index_sequence<rank>{}, indices...);
+  }
+
+  template <class... Indices>
+  void check_bounds(Indices... indices) const {
+    std::array<size_t, rank> idxs{static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < rank; ++r) {
+      if (idxs[r] >= extents_.extent(r)) {
+        throw std::out_of_range("multi dimension subscript out of range");
+      }
+    }
+  }
+
+  constexpr const Extents& extents() const noexcept { return extents_; }
+
+ private:
+  template <size_t... R, class... Indices>
+  constexpr size_t offset(std::index_sequence<R...>, Indices... indices) const noexcept {
+    return ((static_cast<size_t>(indices) * stride<R>()) + ... + size_t(0));
+  }
+
+  Extents extents_;
+  std::array<size_t, rank> strides_{};
+};
+
+// 分块布局没有步长 偏移按块计算 全部为静态维度时可在编译期求值
+template <class Extents, size_t TR, size_t TC, size_t TD>
+class layout_mapping<Extents, layout_tiled<TR, TC, TD>> {
+ public:
+  static constexpr size_t rank = Extents::rank;
+
+  constexpr layout_mapping() noexcept = default;
+
+  explicit layout_mapping(const Extents& ext) noexcept : extents_(ext) {}
+
+  template <class... Indices>
+  constexpr size_t operator()(Indices... indices) const noexcept {
+    static_assert(sizeof...(Indices) == rank, "Number of indices must match Rank");
+    return tiled_index<layout_tiled<TR, TC, TD>, rank>(extents_array(), {static_cast<size_t>(indices)...});
+  }
+
+  template <class... Indices>
+  void check_bounds(Indices... indices) const {
+    std::array<size_t, rank> idxs{static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < rank; ++r) {
+      if (idxs[r] >= extents_.extent(r)) {
+        throw std::out_of_range("multi dimension subscript out of range");
+      }
+    }
+  }
+
+  constexpr const Extents& extents() const noexcept { return extents_; }
+
+ private:
+  constexpr std::array<size_t, rank> extents_array() const noexcept {
+    std::array<size_t, rank> res{};
+    for (size_t r = 0; r < rank; ++r) {
+      res[r] = extents_.extent(r);
+    }
+    return res;
+  }
+
+  Extents extents_;
+};
+
+// 静态/动态混合维度的视图 不拥有数据
+template <class T, class Extents, class Layout = layout_right>
+class static_mdspan {
+ public:
+  using mapping_type = layout_mapping<Extents, Layout>;
+
+  constexpr static_mdspan() noexcept = default;
+
+  static_mdspan(T* data, const Extents& ext) noexcept : data_(data), mapping_(ext) {}
+
+  template <class... Indices>
+  constexpr T& operator()(Indices... indices) const noexcept {
+    return data_[mapping_(indices...)];
+  }
+
+#if defined(__cpp_multidimensional_subscript) || __cplusplus >= 202302L
+  template <class... Indices>
+  constexpr T& operator[](Indices... indices) const noexcept {
+    return data_[mapping_(indices...)];
+  }
+#endif
+
+  template <class... Indices>
+  T& at(Indices... indices) const {
+    mapping_.check_bounds(indices...);
+    return data_[mapping_(indices...)];
+  }
+
+  static constexpr size_t rank() noexcept { return Extents::rank; }
+
+  constexpr size_t extent(size_t r) const noexcept { return mapping_.extents().extent(r); }
+
+  std::array<size_t, Extents::rank> extents() const noexcept { return mapping_.extents().to_array(); }
+
+  constexpr size_t size() const noexcept { return mapping_.extents().size(); }
+
+  T* data() const noexcept { return data_; }
+
+  const mapping_type& mapping() const noexcept { return mapping_; }
+
+ private:
+  T* data_ = nullptr;
+  mapping_type mapping_;
+};
+
+}  // namespace md
+
+#endif  // __MDVECTOR_EXTENTS_H__
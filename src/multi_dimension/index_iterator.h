@@ -0,0 +1,171 @@
+#ifndef __MDVECTOR_INDEX_ITERATOR_H__
+#define __MDVECTOR_INDEX_ITERATOR_H__
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "detail.h"
+#include "extents.h"
+#include "span.h"
+
+template <class T, class Layout, class Enable, size_t... lengths>
+class mdarray_base;
+
+namespace md {
+
+// 按内存顺序遍历多维下标 每步只更新最快变化的维度 进位时才涉及外层维度
+template <size_t Rank, class Layout = layout_right>
+class index_iterator {
+ public:
+  index_iterator(const std::array<size_t, Rank>& extents, const std::array<size_t, Rank>& strides) noexcept
+      : extents_(extents), strides_(strides) {
+    for (size_t r = 0; r < Rank; ++r) {
+      if (extents_[r] == 0) done_ = true;
+    }
+  }
+
+  // 第k快变化的维度
+  static constexpr size_t dim(size_t k) noexcept {
+    if constexpr (std::is_same_v<Layout, layout_right>) {
+      return Rank - 1 - k;
+    } else {
+      return k;
+    }
+  }
+
+  const std::array<size_t, Rank>& operator*() const noexcept { return index_; }
+
+  const std::array<size_t, Rank>& index() const noexcept { return index_; }
+
+  // 当前下标对应的元素偏移
+  size_t offset() const noexcept { return offset_; }
+
+  bool done() const noexcept { return done_; }
+
+  index_iterator& operator++() noexcept {
+    for (size_t k = 0; k < Rank; ++k) {
+      const size_t d = dim(k);
+      offset_ += strides_[d];
+      if (++index_[d] < extents_[d]) return *this;
+      // 进位 当前维度归零
+      offset_ -= extents_[d] * strides_[d];
+      index_[d] = 0;
+    }
+    done_ = true;
+    return *this;
+  }
+
+ private:
+  std::array<size_t, Rank> extents_;
+  std::array<size_t, Rank> strides_;
+  std::array<size_t, Rank> index_{};
+  size_t offset_ = 0;
+  bool done_ = false;
+};
+
+struct index_sentinel {};
+
+template <size_t Rank, class Layout>
+bool operator!=(const index_iterator<Rank, Layout>& it, index_sentinel) noexcept {
+  return !it.done();
+}
+
+template <size_t Rank, class Layout>
+bool operator==(const index_iterator<Rank, Layout>& it, index_sentinel) noexcept {
+  return it.done();
+}
+
+// 数据指针 + 维度 + 步长
+template <class T, size_t Rank, class Layout>
+struct index_space {
+  T* data;
+  std::array<size_t, Rank> extents;
+  std::array<size_t, Rank> strides;
+
+  index_iterator<Rank, Layout> begin() const noexcept { return {extents, strides}; }
+  index_sentinel end() const noexcept { return {}; }
+};
+
+template <class T, size_t Rank, class Layout>
+index_space<T, Rank, Layout> make_index_space(T* data, const std::array<size_t, Rank>& extents) noexcept {
+  return {data, extents, compute_strides<Rank, Layout>(extents)};
+}
+
+template <class T, size_t Rank, class Layout>
+auto indices(::mdvector<T, Rank, Layout>& v) noexcept {
+  return make_index_space<T, Rank, Layout>(v.begin(), v.extents());
+}
+
+template <class T, size_t Rank, class Layout>
+auto indices(const ::mdvector<T, Rank, Layout>& v) noexcept {
+  return make_index_space<const T, Rank, Layout>(v.begin(), v.extents());
+}
+
+template <class T, class Layout, size_t... lengths>
+auto indices(::mdarray_base<T, Layout, void, lengths...>& v) noexcept {
+  return make_index_space<T, sizeof...(lengths), Layout>(v.begin(), v.extents());
+}
+
+template <class T, class Layout, size_t... lengths>
+auto indices(const ::mdarray_base<T, Layout, void, lengths...>& v) noexcept {
+  return make_index_space<const T, sizeof...(lengths), Layout>(v.begin(), v.extents());
+}
+
+template <class T, size_t Rank, class Layout>
+auto indices(span<T, Rank, Layout>& v) noexcept {
+  return make_index_space<T, Rank, Layout>(v.begin(), v.extents());
+}
+
+template <class T, size_t Rank, class Layout>
+auto indices(const span<T, Rank, Layout>& v) noexcept {
+  return make_index_space<const T, Rank, Layout>(v.begin(), v.extents());
+}
+
+template <class T, class Extents, class Layout>
+auto indices(const static_mdspan<T, Extents, Layout>& v) noexcept {
+  return make_index_space<T, Extents::rank, Layout>(v.data(), v.extents());
+}
+
+// 逐行遍历 fn(index, row, n) 最内层(内存连续)维度整行交给回调 便于simd处理
+// index中最内层维度为0 row指向该行首元素 n为行长度
+template <class T, size_t Rank, class Layout, class F>
+void for_each_row(const index_space<T, Rank, Layout>& space, F&& fn) {
+  constexpr size_t inner = index_iterator<Rank, Layout>::dim(0);
+  std::array<size_t, Rank> outer_extents = space.extents;
+  outer_extents[inner] = 1;
+  const size_t n = space.extents[inner];
+  if (n == 0) return;
+
+  for (index_iterator<Rank, Layout> it(outer_extents, space.strides); !it.done(); ++it) {
+    fn(it.index(), space.data + it.offset(), n);
+  }
+}
+
+// 逐元素遍历 fn(index, value) 下标按内存顺序递增更新 不重新计算线性偏移
+template <class T, size_t Rank, class Layout, class F>
+void for_each_index(const index_space<T, Rank, Layout>& space, F&& fn) {
+  constexpr size_t inner = index_iterator<Rank, Layout>::dim(0);
+  const size_t stride = space.strides[inner];
+  for_each_row(space, [&fn, stride](const std::array<size_t, Rank>& row_index, T* row, size_t n) {
+    std::array<size_t, Rank> index = row_index;
+    for (size_t i = 0; i < n; ++i) {
+      index[inner] = i;
+      fn(static_cast<const std::array<size_t, Rank>&>(index), row[i * stride]);
+    }
+  });
+}
+
+template <class V, class F, class = decltype(indices(std::declval<V&>()))>
+void for_each_row(V&& v, F&& fn) {
+  for_each_row(indices(v), std::forward<F>(fn));
+}
+
+template <class V, class F, class = decltype(indices(std::declval<V&>()))>
+void for_each_index(V&& v, F&& fn) {
+  for_each_index(indices(v), std::forward<F>(fn));
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_INDEX_ITERATOR_H__
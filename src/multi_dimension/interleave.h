@@ -0,0 +1,101 @@
+#ifndef __MDVECTOR_INTERLEAVE_H__
+#define __MDVECTOR_INTERLEAVE_H__
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+#include "mdvector.h"
+#include "parallel/thread_pool.h"
+#include "simd/allocator.h"
+
+namespace md {
+
+namespace detail {
+
+// 记录[begin, end) 整包由后端shuffle序列处理 尾部逐元素处理
+template <size_t N, class T>
+void deinterleave_range(const T* aos, T* const* rows, size_t begin, size_t end) {
+  constexpr size_t P = simd<T>::pack_size;
+  size_t i = begin;
+  for (; i + P <= end; i += P) {
+    simd<T>::template deinterleave<N>(aos + i * N, rows, i);
+  }
+  for (; i < end; ++i) {
+    deinterleave_scalar<N, 1>(aos + i * N, rows, i);
+  }
+}
+
+template <size_t N, class T>
+void interleave_range(const T* const* rows, T* aos, size_t begin, size_t end) {
+  constexpr size_t P = simd<T>::pack_size;
+  size_t i = begin;
+  for (; i + P <= end; i += P) {
+    simd<T>::template interleave<N>(rows, aos + i * N, i);
+  }
+  for (; i < end; ++i) {
+    interleave_scalar<N, 1>(rows, aos + i * N, i);
+  }
+}
+
+// 按记录划分 分界为缓存行元素数的整数倍
+template <class Body>
+void run_records(size_t n, Body&& body) {
+  auto& pool = thread_pool::instance();
+  if (n < parallel_min_size || pool.size() == 1) {
+    body(size_t(0), n);
+    return;
+  }
+  pool.run([&](size_t part) {
+    const auto range = static_partition(n, pool.size(), part, cache_line_bytes);
+    if (range.first < range.second) body(range.first, range.second);
+  });
+}
+
+// 形状为{N, n}的行优先数组中各分量所在行
+template <size_t N, class T, class U, class Layout>
+std::array<T*, N> soa_rows(U* data, const mdvector<std::remove_const_t<U>, 2, Layout>& soa) {
+  static_assert(std::is_same_v<Layout, layout_right>, "soa must be row-major with shape {N, n}");
+  if (soa.extent(0) != N) {
+    throw std::invalid_argument("interleave: soa extent(0) must equal number of components");
+  }
+  std::array<T*, N> rows;
+  for (size_t c = 0; c < N; ++c) rows[c] = data + c * soa.extent(1);
+  return rows;
+}
+
+}  // namespace detail
+
+// 交错存放的N分量记录 -> 形状为{N, n}的mdvector 第c行为第c个分量
+// 例: struct pos3d { double x, y, z; };
+//     md::deinterleave<3>(&pos[0].x, soa);  // soa({3, pos.size()})
+template <size_t N, class T, class Layout>
+void deinterleave(const T* aos, mdvector<T, 2, Layout>& soa) {
+  const auto rows = detail::soa_rows<N, T>(soa.begin(), soa);
+  detail::deinterleave_range<N>(aos, rows.data(), 0, soa.extent(1));
+}
+
+template <size_t N, class T, class Layout>
+void deinterleave(const T* aos, mdvector<T, 2, Layout>& soa, parallel_t) {
+  const auto rows = detail::soa_rows<N, T>(soa.begin(), soa);
+  detail::run_records(soa.extent(1),
+                      [&](size_t begin, size_t end) { detail::deinterleave_range<N>(aos, rows.data(), begin, end); });
+}
+
+// 形状为{N, n}的mdvector -> 交错存放的N分量记录 aos需有N * n个元素的空间
+template <size_t N, class T, class Layout>
+void interleave(const mdvector<T, 2, Layout>& soa, T* aos) {
+  const auto rows = detail::soa_rows<N, const T>(soa.begin(), soa);
+  detail::interleave_range<N>(rows.data(), aos, 0, soa.extent(1));
+}
+
+template <size_t N, class T, class Layout>
+void interleave(const mdvector<T, 2, Layout>& soa, T* aos, parallel_t) {
+  const auto rows = detail::soa_rows<N, const T>(soa.begin(), soa);
+  detail::run_records(soa.extent(1),
+                      [&](size_t begin, size_t end) { detail::interleave_range<N>(rows.data(), aos, begin, end); });
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_INTERLEAVE_H__
@@ -0,0 +1,84 @@
+#ifndef __MDVECTOR_LAYOUT_TILED_H__
+#define __MDVECTOR_LAYOUT_TILED_H__
+
+#include <algorithm>
+#include <array>
+
+#include "mdvector.h"
+
+namespace md {
+
+// 按分块顺序遍历 每段为块内一行(最内层维度上的连续一段) 在行优先布局中同样连续
+// fn(tiled_offset, row_major_offset, n) 分块布局一侧的偏移严格递增
+template <class Tiled, size_t Rank, class F>
+void for_each_tile_run(const std::array<size_t, Rank>& extents, F&& fn) {
+  static_assert(is_tiled_layout_v<Tiled>, "Tiled must be layout_tiled");
+  static_assert(Rank == 2 || Rank == 3, "layout_tiled supports rank 2 and 3");
+  constexpr auto tile = Tiled::tile;
+  auto clip = [](size_t start, size_t t, size_t n) { return n - start < t ? n - start : t; };
+
+  size_t tiled = 0;
+  if constexpr (Rank == 2) {
+    for (size_t i0 = 0; i0 < extents[0]; i0 += tile[0]) {
+      const size_t h0 = clip(i0, tile[0], extents[0]);
+      for (size_t j0 = 0; j0 < extents[1]; j0 += tile[1]) {
+        const size_t h1 = clip(j0, tile[1], extents[1]);
+        for (size_t i = i0; i < i0 + h0; ++i) {
+          fn(tiled, i * extents[1] + j0, h1);
+          tiled += h1;
+        }
+      }
+    }
+  } else {
+    for (size_t i0 = 0; i0 < extents[0]; i0 += tile[0]) {
+      const size_t h0 = clip(i0, tile[0], extents[0]);
+      for (size_t j0 = 0; j0 < extents[1]; j0 += tile[1]) {
+        const size_t h1 = clip(j0, tile[1], extents[1]);
+        for (size_t k0 = 0; k0 < extents[2]; k0 += tile[2]) {
+          const size_t h2 = clip(k0, tile[2], extents[2]);
+          for (size_t i = i0; i < i0 + h0; ++i) {
+            for (size_t j = j0; j < j0 + h1; ++j) {
+              fn(tiled, (i * extents[1] + j) * extents[2] + k0, h2);
+              tiled += h2;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// 行优先 -> 分块 顺序写出目标内存
+template <class Tiled, class T, size_t Rank>
+void tile_copy(const T* row_major, T* tiled, const std::array<size_t, Rank>& extents) {
+  for_each_tile_run<Tiled>(extents, [row_major, tiled](size_t t, size_t r, size_t n) {
+    std::copy_n(row_major + r, n, tiled + t);
+  });
+}
+
+// 分块 -> 行优先 顺序读入源内存
+template <class Tiled, class T, size_t Rank>
+void untile_copy(const T* tiled, T* row_major, const std::array<size_t, Rank>& extents) {
+  for_each_tile_run<Tiled>(extents, [row_major, tiled](size_t t, size_t r, size_t n) {
+    std::copy_n(tiled + t, n, row_major + r);
+  });
+}
+
+// 例: auto t = md::to_tiled<md::layout_tiled<8, 8>>(v);
+template <class Tiled, class T, size_t Rank>
+mdvector<T, Rank, Tiled> to_tiled(const mdvector<T, Rank, layout_right>& src) {
+  mdvector<T, Rank, Tiled> res(src.extents(), uninitialized);
+  tile_copy<Tiled>(src.begin(), res.begin(), src.extents());
+  return res;
+}
+
+template <class T, size_t Rank, size_t TR, size_t TC, size_t TD>
+mdvector<T, Rank, layout_right> to_row_major(const mdvector<T, Rank, layout_tiled<TR, TC, TD>>& src) {
+  mdvector<T, Rank, layout_right> res(src.extents(), uninitialized);
+  untile_copy<layout_tiled<TR, TC, TD>>(src.begin(), res.begin(), src.extents());
+  return res;
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_LAYOUT_TILED_H__
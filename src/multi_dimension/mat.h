@@ -0,0 +1,496 @@
+#ifndef __MDVECTOR_MAT_H__
+#define __MDVECTOR_MAT_H__
+
+#include <cmath>
+#include <utility>
+
+#include "batch_kernel.h"
+
+namespace md {
+
+// 批量小矩阵(2x2/3x3/4x4)运算 数据为形状{D, D, n}的SoA: 元素(r, c)位于第r*D+c行
+// 每个simd通道为一个矩阵 D在编译期确定 各分量的运算全部编译期展开
+// 例: auto inv = md::mat::inverse(jacobian); jacobian的形状为{3, 3, n}
+namespace mat {
+
+template <class T, size_t D>
+using packs = batch::pack_array<T, D * D>;
+
+namespace detail {
+
+// a * b - c * d
+template <class T>
+inline batch::pack_t<T> diff(const batch::pack_t<T>& a, const batch::pack_t<T>& b, const batch::pack_t<T>& c,
+                             const batch::pack_t<T>& d) {
+  return simd<T>::sub(simd<T>::mul(a, b), simd<T>::mul(c, d));
+}
+
+// a0 * b0 - a1 * b1 + a2 * b2
+template <class T>
+inline batch::pack_t<T> alternate(const batch::pack_t<T>& a0, const batch::pack_t<T>& b0, const batch::pack_t<T>& a1,
+                                  const batch::pack_t<T>& b1, const batch::pack_t<T>& a2, const batch::pack_t<T>& b2) {
+  return simd<T>::sub(simd<T>::fma(a0, b0, simd<T>::mul(a2, b2)), simd<T>::mul(a1, b1));
+}
+
+// 3x3的代数余子式 下标循环取值 符号已包含在内
+template <class T, size_t I, size_t J>
+inline batch::pack_t<T> cofactor3(const packs<T, 3>& a) {
+  constexpr size_t i1 = (I + 1) % 3, i2 = (I + 2) % 3, j1 = (J + 1) % 3, j2 = (J + 2) % 3;
+  return diff<T>(a[i1 * 3 + j1], a[i2 * 3 + j2], a[i1 * 3 + j2], a[i2 * 3 + j1]);
+}
+
+// 4x4按两行一组展开: s为前两行的2x2子式 c为后两行的2x2子式
+// 列对依次为(0,1) (0,2) (0,3) (1,2) (1,3) (2,3)
+template <class T>
+struct minors4 {
+  batch::pack_array<T, 6> s;
+  batch::pack_array<T, 6> c;
+};
+
+template <class T>
+inline minors4<T> make_minors4(const packs<T, 4>& a) {
+  constexpr size_t p[6] = {0, 0, 0, 1, 1, 2};
+  constexpr size_t q[6] = {1, 2, 3, 2, 3, 3};
+  minors4<T> m;
+  batch::unroll<6>([&](auto k) {
+    m.s[k] = diff<T>(a[p[k]], a[4 + q[k]], a[4 + p[k]], a[q[k]]);
+    m.c[k] = diff<T>(a[8 + p[k]], a[12 + q[k]], a[12 + p[k]], a[8 + q[k]]);
+  });
+  return m;
+}
+
+template <class T>
+inline batch::pack_t<T> det4(const minors4<T>& m) {
+  using S = simd<T>;
+  const auto& s = m.s;
+  const auto& c = m.c;
+  return S::sub(S::fma(s[0], c[5], S::fma(s[2], c[3], S::fma(s[3], c[2], S::mul(s[5], c[0])))),
+                S::fma(s[1], c[4], S::mul(s[4], c[1])));
+}
+
+template <size_t D, class T>
+inline batch::pack_t<T> det(const packs<T, D>& a) {
+  using S = simd<T>;
+  if constexpr (D == 2) {
+    return diff<T>(a[0], a[3], a[1], a[2]);
+  } else if constexpr (D == 3) {
+    return S::fma(a[0], cofactor3<T, 0, 0>(a), S::fma(a[1], cofactor3<T, 0, 1>(a), S::mul(a[2], cofactor3<T, 0, 2>(a))));
+  } else {
+    return det4<T>(make_minors4<T>(a));
+  }
+}
+
+// 伴随矩阵除以行列式 奇异矩阵的结果为inf/nan
+template <size_t D, class T>
+inline packs<T, D> inverse(const packs<T, D>& a) {
+  using S = simd<T>;
+  packs<T, D> res;
+  if constexpr (D == 2) {
+    const auto inv = S::div(S::set1(T(1)), det<2, T>(a));
+    const auto neg = S::sub(S::set1(T(0)), inv);
+    res = {S::mul(a[3], inv), S::mul(a[1], neg), S::mul(a[2], neg), S::mul(a[0], inv)};
+  } else if constexpr (D == 3) {
+    packs<T, 3> cof;
+    batch::unroll<9>([&](auto k) { cof[k] = cofactor3<T, k / 3, k % 3>(a); });
+    const auto inv = S::div(S::set1(T(1)), S::fma(a[0], cof[0], S::fma(a[1], cof[1], S::mul(a[2], cof[2]))));
+    batch::unroll<9>([&](auto k) { res[k] = S::mul(cof[(k % 3) * 3 + k / 3], inv); });
+  } else {
+    // 第j列的余子式取自第row[j]行与另一组的子式 第i行取除i以外的三列
+    constexpr size_t row[4] = {1, 0, 3, 2};
+    constexpr size_t col[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+    constexpr size_t minor[4][3] = {{5, 4, 3}, {5, 2, 1}, {4, 2, 0}, {3, 1, 0}};
+    const auto m = make_minors4<T>(a);
+    const auto inv = S::div(S::set1(T(1)), det4<T>(m));
+    const auto neg = S::sub(S::set1(T(0)), inv);
+    batch::unroll<16>([&](auto k) {
+      constexpr size_t i = k / 4, j = k % 4;
+      const auto& sc = j < 2 ? m.c : m.s;
+      const size_t r = row[j] * 4;
+      const auto v = alternate<T>(a[r + col[i][0]], sc[minor[i][0]], a[r + col[i][1]], sc[minor[i][1]],
+                                  a[r + col[i][2]], sc[minor[i][2]]);
+      res[k] = S::mul(v, (i + j) % 2 ? neg : inv);
+    });
+  }
+  return res;
+}
+
+template <size_t D, class T>
+inline packs<T, D> transpose(const packs<T, D>& a) {
+  packs<T, D> res;
+  batch::unroll<D * D>([&](auto k) { res[k] = a[(k % D) * D + k / D]; });
+  return res;
+}
+
+template <size_t D, class T>
+inline packs<T, D> matmul(const packs<T, D>& a, const packs<T, D>& b) {
+  packs<T, D> res;
+  batch::unroll<D * D>([&](auto k) {
+    constexpr size_t i = k / D, j = k % D;
+    auto acc = simd<T>::mul(a[i * D + D - 1], b[(D - 1) * D + j]);
+    batch::unroll<D - 1>([&](auto m) { acc = simd<T>::fma(a[i * D + m], b[m * D + j], acc); });
+    res[k] = acc;
+  });
+  return res;
+}
+
+template <size_t D, class T>
+inline batch::pack_array<T, D> matvec(const packs<T, D>& a, const batch::pack_array<T, D>& x) {
+  batch::pack_array<T, D> res;
+  batch::unroll<D>([&](auto i) {
+    auto acc = simd<T>::mul(a[i * D + D - 1], x[D - 1]);
+    batch::unroll<D - 1>([&](auto m) { acc = simd<T>::fma(a[i * D + m], x[m], acc); });
+    res[i] = acc;
+  });
+  return res;
+}
+
+// 实对称矩阵的特征值 升序 只读取上三角
+// 3x3用三角函数解法: 不变量在simd中计算 acos/cos逐通道计算
+template <size_t D, class T>
+inline batch::pack_array<T, D> eigvalsh(const packs<T, D>& a) {
+  using S = simd<T>;
+  if constexpr (D == 2) {
+    const auto half = S::set1(T(0.5));
+    const auto mean = S::mul(S::add(a[0], a[3]), half);
+    const auto h = S::mul(S::sub(a[0], a[3]), half);
+    const auto r = S::sqrt(S::fma(h, h, S::mul(a[1], a[1])));
+    return {S::sub(mean, r), S::add(mean, r)};
+  } else {
+    constexpr size_t P = simd<T>::pack_size;
+    const auto q = S::mul(S::add(a[0], S::add(a[4], a[8])), S::set1(T(1) / T(3)));
+    const auto b0 = S::sub(a[0], q), b4 = S::sub(a[4], q), b8 = S::sub(a[8], q);
+    const auto off = S::fma(a[1], a[1], S::fma(a[2], a[2], S::mul(a[5], a[5])));
+    const auto p = S::sqrt(S::mul(S::fma(b0, b0, S::fma(b4, b4, S::fma(b8, b8, S::add(off, off)))), S::set1(T(1) / T(6))));
+    const auto d = det<3, T>({b0, a[1], a[2], a[1], b4, a[5], a[2], a[5], b8});
+
+    T pl[P], dl[P], c1[P], c3[P];
+    S::storeu(pl, p);
+    S::storeu(dl, d);
+    for (size_t l = 0; l < P; ++l) {
+      if (pl[l] == T(0)) {
+        // 数量矩阵 三个特征值相等
+        c1[l] = c3[l] = T(0);
+        continue;
+      }
+      T r = dl[l] / (T(2) * pl[l] * pl[l] * pl[l]);
+      r = r < T(-1) ? T(-1) : (r > T(1) ? T(1) : r);
+      const T phi = std::acos(r) / T(3);
+      c1[l] = std::cos(phi);
+      c3[l] = std::cos(phi + T(2.0943951023931954923));
+    }
+    const auto p2 = S::add(p, p);
+    const auto e1 = S::fma(p2, S::loadu(c1), q);
+    const auto e3 = S::fma(p2, S::loadu(c3), q);
+    const auto e2 = S::sub(S::mul(q, S::set1(T(3))), S::add(e1, e3));
+    return {e3, e2, e1};
+  }
+}
+
+// 2x2实对称矩阵[[a, b], [b, d]]较大特征值的单位特征向量(c, s) 较小特征值对应(-s, c)
+// 按h的符号取两种等价写法中不相消的一种 a == d且b == 0时取(1, 0)
+template <class T>
+inline void eigvec2(T a, T b, T d, T& c, T& s) {
+  const T h = (a - d) / T(2);
+  const T r = std::hypot(h, b);
+  if (r == T(0)) {
+    c = T(1), s = T(0);
+    return;
+  }
+  const T x = h >= T(0) ? h + r : b;
+  const T y = h >= T(0) ? b : r - h;
+  const T len = std::hypot(x, y);
+  c = x / len, s = y / len;
+}
+
+inline size_t argmax3(double a, double b, double c) { return a >= b ? (a >= c ? 0 : 2) : (b >= c ? 1 : 2); }
+
+// 3x3实对称矩阵(上三角m)的单位特征向量 w为升序特征值 v[r * 3 + j]为第j个特征向量的第r个分量
+// 与中间值相距最远的特征值是单根: A - wI的零空间由其两行的叉积给出 取模最大的叉积
+// 另外两个特征值可能相等或接近 在该向量的正交补平面内解2x2问题 结果仍正交
+template <class T>
+inline void eigvec3(const T* m, const T* w, T* v) {
+  if (w[0] == w[2]) {
+    // 数量矩阵 任意正交基
+    for (size_t k = 0; k < 9; ++k) v[k] = k % 4 == 0 ? T(1) : T(0);
+    return;
+  }
+  const size_t k = w[2] - w[1] >= w[1] - w[0] ? 2 : 0;
+  const T r[3][3] = {{m[0] - w[k], m[1], m[2]}, {m[1], m[4] - w[k], m[5]}, {m[2], m[5], m[8] - w[k]}};
+  T cross[3][3];
+  T norm[3];
+  for (size_t i = 0; i < 3; ++i) {
+    const T* p = r[i == 2 ? 1 : 0];
+    const T* q = r[i == 0 ? 1 : 2];
+    cross[i][0] = p[1] * q[2] - p[2] * q[1];
+    cross[i][1] = p[2] * q[0] - p[0] * q[2];
+    cross[i][2] = p[0] * q[1] - p[1] * q[0];
+    norm[i] = cross[i][0] * cross[i][0] + cross[i][1] * cross[i][1] + cross[i][2] * cross[i][2];
+  }
+  const size_t best = argmax3(norm[0], norm[1], norm[2]);
+  T u[3] = {T(1), T(0), T(0)};
+  if (norm[best] > T(0)) {
+    const T inv = T(1) / std::sqrt(norm[best]);
+    for (size_t i = 0; i < 3; ++i) u[i] = cross[best][i] * inv;
+  }
+
+  // 正交补平面的基s, t: 与u夹角最大的坐标轴叉乘u
+  const size_t axis = argmax3(-std::fabs(u[0]), -std::fabs(u[1]), -std::fabs(u[2]));
+  T e[3] = {T(0), T(0), T(0)};
+  e[axis] = T(1);
+  T s[3] = {u[1] * e[2] - u[2] * e[1], u[2] * e[0] - u[0] * e[2], u[0] * e[1] - u[1] * e[0]};
+  const T inv = T(1) / std::sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+  for (size_t i = 0; i < 3; ++i) s[i] *= inv;
+  const T t[3] = {u[1] * s[2] - u[2] * s[1], u[2] * s[0] - u[0] * s[2], u[0] * s[1] - u[1] * s[0]};
+
+  const T as[3] = {m[0] * s[0] + m[1] * s[1] + m[2] * s[2], m[1] * s[0] + m[4] * s[1] + m[5] * s[2],
+                   m[2] * s[0] + m[5] * s[1] + m[8] * s[2]};
+  const T at[3] = {m[0] * t[0] + m[1] * t[1] + m[2] * t[2], m[1] * t[0] + m[4] * t[1] + m[5] * t[2],
+                   m[2] * t[0] + m[5] * t[1] + m[8] * t[2]};
+  T c, sn;
+  eigvec2(s[0] * as[0] + s[1] * as[1] + s[2] * as[2], s[0] * at[0] + s[1] * at[1] + s[2] * at[2],
+          t[0] * at[0] + t[1] * at[1] + t[2] * at[2], c, sn);
+
+  // k为2时平面内两个特征值为w0 w1 否则为w1 w2
+  const size_t lo = k == 2 ? 0 : 1;
+  for (size_t i = 0; i < 3; ++i) {
+    v[i * 3 + k] = u[i];
+    v[i * 3 + lo] = c * t[i] - sn * s[i];
+    v[i * 3 + lo + 1] = c * s[i] + sn * t[i];
+  }
+}
+
+// 实对称矩阵的特征值(升序)与单位特征向量 只读取上三角
+// 特征值同eigvalsh 特征向量在退化时需要分支 逐通道计算
+template <size_t D, class T>
+inline std::pair<batch::pack_array<T, D>, packs<T, D>> eigh(const packs<T, D>& a) {
+  using S = simd<T>;
+  constexpr size_t P = simd<T>::pack_size;
+  const auto w = eigvalsh<D, T>(a);
+  T al[D * D][P], wl[D][P], vl[D * D][P];
+  batch::unroll<D * D>([&](auto k) { S::storeu(al[k], a[k]); });
+  batch::unroll<D>([&](auto k) { S::storeu(wl[k], w[k]); });
+  for (size_t l = 0; l < P; ++l) {
+    if constexpr (D == 2) {
+      T c, s;
+      eigvec2(al[0][l], al[1][l], al[3][l], c, s);
+      vl[0][l] = -s, vl[1][l] = c, vl[2][l] = c, vl[3][l] = s;
+    } else {
+      T m[9], e[3], v[9];
+      for (size_t k = 0; k < 9; ++k) m[k] = al[k][l];
+      for (size_t k = 0; k < 3; ++k) e[k] = wl[k][l];
+      eigvec3(m, e, v);
+      for (size_t k = 0; k < 9; ++k) vl[k][l] = v[k];
+    }
+  }
+  packs<T, D> v;
+  batch::unroll<D * D>([&](auto k) { v[k] = S::loadu(vl[k]); });
+  return {w, v};
+}
+
+// 按矩阵维度分派到编译期版本 fn(std::integral_constant<size_t, D>)
+template <size_t MaxD, class T, class F>
+void dispatch(const mdvector<T, 3>& a, const char* who, F&& fn) {
+  const size_t d = a.extent(0);
+  if (a.extent(1) != d) {
+    throw std::invalid_argument(std::string(who) + ": matrices must be square");
+  }
+  if (d == 2) {
+    fn(std::integral_constant<size_t, 2>{});
+  } else if (d == 3) {
+    fn(std::integral_constant<size_t, 3>{});
+  } else if constexpr (MaxD >= 4) {
+    if (d != 4) throw std::invalid_argument(std::string(who) + ": only 2x2, 3x3 and 4x4 matrices are supported");
+    fn(std::integral_constant<size_t, 4>{});
+  } else {
+    throw std::invalid_argument(std::string(who) + ": only 2x2 and 3x3 matrices are supported");
+  }
+}
+
+template <class T>
+void check_same_size(const mdvector<T, 3>& a, const mdvector<T, 3>& b, const char* who) {
+  if (a.extent(0) != b.extent(0) || a.extent(1) != b.extent(1)) {
+    throw std::invalid_argument(std::string(who) + ": operands must have the same matrix size");
+  }
+  batch::check_count(a, b, who);
+}
+
+}  // namespace detail
+
+// out(i) = det(a(:, :, i))
+template <class T>
+void det(const mdvector<T, 3>& a, mdvector<T, 1>& out) {
+  detail::dispatch<4>(a, "mat::det", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::det");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<1>(out, {n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      batch::store<F>(res[0] + i, rem, detail::det<D, T>(batch::load_components<F>(ra, i, rem)));
+    });
+  });
+}
+
+// out(:, :, i) = a(:, :, i)^-1 不做主元选取 奇异矩阵的结果为inf/nan
+// out可以与a为同一对象
+template <class T>
+void inverse(const mdvector<T, 3>& a, mdvector<T, 3>& out) {
+  detail::dispatch<4>(a, "mat::inverse", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::inverse");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<D * D>(out, {D, D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r = detail::inverse<D, T>(batch::load_components<F>(ra, i, rem));
+      batch::unroll<D * D>([&](auto k) { batch::store<F>(res[k] + i, rem, r[k]); });
+    });
+  });
+}
+
+// out(:, :, i) = a(:, :, i)^T out可以与a为同一对象
+template <class T>
+void transpose(const mdvector<T, 3>& a, mdvector<T, 3>& out) {
+  detail::dispatch<4>(a, "mat::transpose", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::transpose");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<D * D>(out, {D, D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r = detail::transpose<D, T>(batch::load_components<F>(ra, i, rem));
+      batch::unroll<D * D>([&](auto k) { batch::store<F>(res[k] + i, rem, r[k]); });
+    });
+  });
+}
+
+// out(:, :, i) = a(:, :, i) b(:, :, i) out可以与a或b为同一对象
+template <class T>
+void matmul(const mdvector<T, 3>& a, const mdvector<T, 3>& b, mdvector<T, 3>& out) {
+  detail::check_same_size(a, b, "mat::matmul");
+  detail::dispatch<4>(a, "mat::matmul", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::matmul");
+    const auto rb = batch::component_rows<D * D>(b, "mat::matmul");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<D * D>(out, {D, D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r =
+          detail::matmul<D, T>(batch::load_components<F>(ra, i, rem), batch::load_components<F>(rb, i, rem));
+      batch::unroll<D * D>([&](auto k) { batch::store<F>(res[k] + i, rem, r[k]); });
+    });
+  });
+}
+
+// out(:, i) = a(:, :, i) x(:, i) x与out的形状为{D, n} out可以与x为同一对象
+template <class T>
+void matvec(const mdvector<T, 3>& a, const mdvector<T, 2>& x, mdvector<T, 2>& out) {
+  batch::check_count(a, x, "mat::matvec");
+  detail::dispatch<4>(a, "mat::matvec", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::matvec");
+    const auto rx = batch::component_rows<D>(x, "mat::matvec");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<D>(out, {D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r =
+          detail::matvec<D, T>(batch::load_components<F>(ra, i, rem), batch::load_components<F>(rx, i, rem));
+      batch::unroll<D>([&](auto k) { batch::store<F>(res[k] + i, rem, r[k]); });
+    });
+  });
+}
+
+// out(:, i)为实对称矩阵a(:, :, i)的特征值 升序 只支持2x2与3x3 只读取上三角
+template <class T>
+void eigvalsh(const mdvector<T, 3>& a, mdvector<T, 2>& out) {
+  detail::dispatch<3>(a, "mat::eigvalsh", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::eigvalsh");
+    const size_t n = a.extent(2);
+    const auto res = batch::output_rows<D>(out, {D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r = detail::eigvalsh<D, T>(batch::load_components<F>(ra, i, rem));
+      batch::unroll<D>([&](auto k) { batch::store<F>(res[k] + i, rem, r[k]); });
+    });
+  });
+}
+
+// values(:, i)为实对称矩阵a(:, :, i)的特征值 升序 vectors(:, j, i)为values(j, i)对应的单位特征向量
+// 特征向量两两正交 符号不定 只支持2x2与3x3 只读取上三角
+template <class T>
+void eigh(const mdvector<T, 3>& a, mdvector<T, 2>& values, mdvector<T, 3>& vectors) {
+  detail::dispatch<3>(a, "mat::eigh", [&](auto dim) {
+    constexpr size_t D = dim;
+    const auto ra = batch::component_rows<D * D>(a, "mat::eigh");
+    const size_t n = a.extent(2);
+    const auto rw = batch::output_rows<D>(values, {D, n});
+    const auto rv = batch::output_rows<D * D>(vectors, {D, D, n});
+    batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+      constexpr bool F = decltype(full)::value;
+      const auto r = detail::eigh<D, T>(batch::load_components<F>(ra, i, rem));
+      batch::unroll<D>([&](auto k) { batch::store<F>(rw[k] + i, rem, r.first[k]); });
+      batch::unroll<D * D>([&](auto k) { batch::store<F>(rv[k] + i, rem, r.second[k]); });
+    });
+  });
+}
+
+// 返回新数组的版本
+template <class T>
+mdvector<T, 1> det(const mdvector<T, 3>& a) {
+  mdvector<T, 1> res({a.extent(2)}, md::uninitialized);
+  det(a, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 3> inverse(const mdvector<T, 3>& a) {
+  mdvector<T, 3> res(a.extents(), md::uninitialized);
+  inverse(a, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 3> transpose(const mdvector<T, 3>& a) {
+  mdvector<T, 3> res(a.extents(), md::uninitialized);
+  transpose(a, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 3> matmul(const mdvector<T, 3>& a, const mdvector<T, 3>& b) {
+  mdvector<T, 3> res(a.extents(), md::uninitialized);
+  matmul(a, b, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> matvec(const mdvector<T, 3>& a, const mdvector<T, 2>& x) {
+  mdvector<T, 2> res({a.extent(0), a.extent(2)}, md::uninitialized);
+  matvec(a, x, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> eigvalsh(const mdvector<T, 3>& a) {
+  mdvector<T, 2> res({a.extent(0), a.extent(2)}, md::uninitialized);
+  eigvalsh(a, res);
+  return res;
+}
+
+// auto [w, v] = md::mat::eigh(a);
+template <class T>
+std::pair<mdvector<T, 2>, mdvector<T, 3>> eigh(const mdvector<T, 3>& a) {
+  std::pair<mdvector<T, 2>, mdvector<T, 3>> res{mdvector<T, 2>({a.extent(0), a.extent(2)}, md::uninitialized),
+                                                mdvector<T, 3>(a.extents(), md::uninitialized)};
+  eigh(a, res.first, res.second);
+  return res;
+}
+
+}  // namespace mat
+
+}  // namespace md
+
+#endif  // __MDVECTOR_MAT_H__
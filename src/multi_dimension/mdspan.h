@@ -11,7 +11,10 @@ class mdspan {
   constexpr mdspan() noexcept = default;
 
   constexpr mdspan(T* data, const std::array<std::size_t, Rank>& extents)
-      : data_(data), extents_(extents), strides_(md::compute_strides<Rank, Layout>(extents)) {
+      : data_(data), extents_(extents) {
+    if constexpr (!is_tiled_layout_v<Layout>) {
+      strides_ = md::compute_strides<Rank, Layout>(extents);
+    }
     size_ = 1;
     for (auto s : extents) {
       size_ *= s;
@@ -33,7 +36,7 @@ class mdspan {
   constexpr T& operator()(Indices... indices) {
     static_assert(sizeof...(Indices) == Rank, "Number of indices must match Rank");
     std::array<std::size_t, Rank> idxs{static_cast<std::size_t>(indices)...};
-    return data_[md::linear_index(strides_, idxs)];
+    return data_[md::linear_index<Layout>(extents_, strides_, idxs)];
   }
 
   template <class... Indices>
@@ -41,7 +44,7 @@ class mdspan {
     static_assert(sizeof...(Indices) == Rank, "Number of indices must match Rank");
     check_bounds(indices...);
     std::array<std::size_t, Rank> idxs{static_cast<std::size_t>(indices)...};
-    return data_[md::linear_index(strides_, idxs)];
+    return data_[md::linear_index<Layout>(extents_, strides_, idxs)];
   }
 
   template <class... Indices>
@@ -49,7 +52,7 @@ class mdspan {
     static_assert(sizeof...(Indices) == Rank, "Number of indices must match Rank");
     check_bounds(indices...);
     std::array<std::size_t, Rank> idxs{static_cast<std::size_t>(indices)...};
-    return md::linear_index(strides_, idxs);
+    return md::linear_index<Layout>(extents_, strides_, idxs);
   }
 
   constexpr std::size_t rank() const noexcept { return Rank; }
@@ -70,7 +73,7 @@ class mdspan {
   T* data_ = nullptr;
   size_t size_ = 1;
   std::array<std::size_t, Rank> extents_;
-  std::array<std::size_t, Rank> strides_;
+  std::array<std::size_t, Rank> strides_{};
 };
 
 }  // namespace md
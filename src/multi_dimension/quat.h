@@ -0,0 +1,159 @@
+#ifndef __MDVECTOR_QUAT_H__
+#define __MDVECTOR_QUAT_H__
+
+#include "batch_kernel.h"
+#include "vec3.h"
+
+namespace md {
+
+// 批量四元数运算 数据为形状{4, n}的SoA: 第0/1/2/3行分别为w/x/y/z分量
+// 每个simd通道为一个四元数 乘积用fma展开 一次遍历完成全部分量
+namespace quat {
+
+template <class T>
+using components = batch::pack_array<T, 4>;
+
+// Hamilton积 p * q
+template <class T>
+inline components<T> multiply(const components<T>& p, const components<T>& q) {
+  using S = simd<T>;
+  return {S::sub(S::mul(p[0], q[0]), S::fma(p[1], q[1], S::fma(p[2], q[2], S::mul(p[3], q[3])))),
+          S::fma(p[0], q[1], S::fma(p[1], q[0], S::sub(S::mul(p[2], q[3]), S::mul(p[3], q[2])))),
+          S::fma(p[0], q[2], S::fma(p[2], q[0], S::sub(S::mul(p[3], q[1]), S::mul(p[1], q[3])))),
+          S::fma(p[0], q[3], S::fma(p[3], q[0], S::sub(S::mul(p[1], q[2]), S::mul(p[2], q[1]))))};
+}
+
+template <class T>
+inline batch::pack_t<T> norm2(const components<T>& q) {
+  using S = simd<T>;
+  return S::fma(q[0], q[0], S::fma(q[1], q[1], S::fma(q[2], q[2], S::mul(q[3], q[3]))));
+}
+
+// 单位四元数旋转向量: t = 2 (u x v), v' = v + w t + u x t 其中u为虚部
+template <class T>
+inline batch::pack_array<T, 3> rotate(const components<T>& q, const batch::pack_array<T, 3>& v) {
+  using S = simd<T>;
+  const batch::pack_array<T, 3> u{q[1], q[2], q[3]};
+  auto t = vec3::cross<T>(u, v);
+  const auto two = S::set1(T(2));
+  for (size_t k = 0; k < 3; ++k) t[k] = S::mul(t[k], two);
+  const auto c = vec3::cross<T>(u, t);
+  batch::pack_array<T, 3> res;
+  for (size_t k = 0; k < 3; ++k) res[k] = S::fma(q[0], t[k], S::add(v[k], c[k]));
+  return res;
+}
+
+// out(:, i) = p(:, i) * q(:, i) out可以与p或q为同一对象
+template <class T>
+void multiply(const mdvector<T, 2>& p, const mdvector<T, 2>& q, mdvector<T, 2>& out) {
+  const auto rp = batch::component_rows<4>(p, "quat::multiply");
+  const auto rq = batch::component_rows<4>(q, "quat::multiply");
+  batch::check_count(p, q, "quat::multiply");
+  const size_t n = p.extent(1);
+  const auto res = batch::output_rows<4>(out, {4, n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto r = multiply<T>(batch::load_components<F>(rp, i, rem), batch::load_components<F>(rq, i, rem));
+    for (size_t k = 0; k < 4; ++k) batch::store<F>(res[k] + i, rem, r[k]);
+  });
+}
+
+// out(:, i) = (w, -x, -y, -z)
+template <class T>
+void conjugate(const mdvector<T, 2>& q, mdvector<T, 2>& out) {
+  const auto rq = batch::component_rows<4>(q, "quat::conjugate");
+  const size_t n = q.extent(1);
+  const auto res = batch::output_rows<4>(out, {4, n});
+  const auto zero = simd<T>::set1(T(0));
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto c = batch::load_components<F>(rq, i, rem);
+    batch::store<F>(res[0] + i, rem, c[0]);
+    for (size_t k = 1; k < 4; ++k) batch::store<F>(res[k] + i, rem, simd<T>::sub(zero, c[k]));
+  });
+}
+
+// out(i) = |q(:, i)|
+template <class T>
+void norm(const mdvector<T, 2>& q, mdvector<T, 1>& out) {
+  const auto rq = batch::component_rows<4>(q, "quat::norm");
+  const size_t n = q.extent(1);
+  const auto res = batch::output_rows<1>(out, {n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    batch::store<F>(res[0] + i, rem, simd<T>::sqrt(norm2<T>(batch::load_components<F>(rq, i, rem))));
+  });
+}
+
+// out(:, i) = q(:, i) / |q(:, i)| 乘以rsqrt 零四元数的结果为inf/nan
+// out可以与q为同一对象
+template <class T>
+void normalize(const mdvector<T, 2>& q, mdvector<T, 2>& out) {
+  const auto rq = batch::component_rows<4>(q, "quat::normalize");
+  const size_t n = q.extent(1);
+  const auto res = batch::output_rows<4>(out, {4, n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto c = batch::load_components<F>(rq, i, rem);
+    const auto r = simd<T>::rsqrt(norm2<T>(c));
+    for (size_t k = 0; k < 4; ++k) batch::store<F>(res[k] + i, rem, simd<T>::mul(c[k], r));
+  });
+}
+
+// out(:, i) = q(:, i) * v(:, i) * conj(q(:, i)) q为{4, n}的单位四元数 v与out为{3, n}
+// 不检查q是否为单位四元数 out可以与v为同一对象
+template <class T>
+void rotate(const mdvector<T, 2>& q, const mdvector<T, 2>& v, mdvector<T, 2>& out) {
+  const auto rq = batch::component_rows<4>(q, "quat::rotate");
+  const auto rv = batch::component_rows<3>(v, "quat::rotate");
+  batch::check_count(q, v, "quat::rotate");
+  const size_t n = q.extent(1);
+  const auto res = batch::output_rows<3>(out, {3, n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto r = rotate<T>(batch::load_components<F>(rq, i, rem), batch::load_components<F>(rv, i, rem));
+    for (size_t k = 0; k < 3; ++k) batch::store<F>(res[k] + i, rem, r[k]);
+  });
+}
+
+// 返回新数组的版本
+template <class T>
+mdvector<T, 2> multiply(const mdvector<T, 2>& p, const mdvector<T, 2>& q) {
+  mdvector<T, 2> res({4, p.extent(1)}, md::uninitialized);
+  multiply(p, q, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> conjugate(const mdvector<T, 2>& q) {
+  mdvector<T, 2> res({4, q.extent(1)}, md::uninitialized);
+  conjugate(q, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 1> norm(const mdvector<T, 2>& q) {
+  mdvector<T, 1> res({q.extent(1)}, md::uninitialized);
+  norm(q, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> normalize(const mdvector<T, 2>& q) {
+  mdvector<T, 2> res({4, q.extent(1)}, md::uninitialized);
+  normalize(q, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> rotate(const mdvector<T, 2>& q, const mdvector<T, 2>& v) {
+  mdvector<T, 2> res({3, v.extent(1)}, md::uninitialized);
+  rotate(q, v, res);
+  return res;
+}
+
+}  // namespace quat
+
+}  // namespace md
+
+#endif  // __MDVECTOR_QUAT_H__
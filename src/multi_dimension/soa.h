@@ -0,0 +1,162 @@
+#ifndef __MDVECTOR_SOA_H__
+#define __MDVECTOR_SOA_H__
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "mdvector.h"
+#include "simd/allocator.h"
+#include "storage.h"
+
+namespace md {
+
+// 按序号命名的字段
+template <size_t I>
+struct field {};
+
+namespace detail {
+
+template <class F, class... Fields>
+struct field_index;
+
+template <class F, class... Rest>
+struct field_index<F, F, Rest...> : std::integral_constant<size_t, 0> {};
+
+template <class F, class First, class... Rest>
+struct field_index<F, First, Rest...> : std::integral_constant<size_t, 1 + field_index<F, Rest...>::value> {};
+
+}  // namespace detail
+
+// 结构体数组(SoA) 多个形状相同的字段共用一次分配
+// 字段按顺序排列 起点对齐到缓存行 各字段的访问互不干扰 预取器按固定间隔的多条流工作
+// 为保证对齐 数据总在堆上分配 不使用小数组的内联存储 在scratch_arena上分配时只保证simd对齐
+// 例: struct x {}; struct y {}; struct z {};
+//     md::soa<double, 1, x, y, z> pos({n});
+//     pos.get<x>() = pos.get<y>() * 2.0 + pos.get<z>();
+template <class T, size_t Rank, class... Fields>
+class soa {
+  static_assert(std::is_floating_point_v<T>, "soa fields must be float or double");
+  static_assert(sizeof...(Fields) > 0, "soa needs at least one field");
+
+ public:
+  static constexpr size_t field_count = sizeof...(Fields);
+
+  soa() = default;
+
+  explicit soa(const std::array<size_t, Rank>& dims)
+      : extents_(dims), stride_(field_stride(dims)), data_(stride_ * field_count) {}
+
+  // 不初始化元素 随后整体覆盖
+  soa(const std::array<size_t, Rank>& dims, uninitialized_t)
+      : extents_(dims), stride_(field_stride(dims)), data_(stride_ * field_count, uninitialized) {}
+
+  template <size_t I>
+  md::span<T, Rank> get() noexcept {
+    static_assert(I < field_count, "soa field index out of range");
+    return md::span<T, Rank>(data_.data() + I * stride_, extents_);
+  }
+
+  template <size_t I>
+  md::span<const T, Rank> get() const noexcept {
+    static_assert(I < field_count, "soa field index out of range");
+    return md::span<const T, Rank>(data_.data() + I * stride_, extents_);
+  }
+
+  template <class F>
+  md::span<T, Rank> get() noexcept {
+    return get<detail::field_index<F, Fields...>::value>();
+  }
+
+  template <class F>
+  md::span<const T, Rank> get() const noexcept {
+    return get<detail::field_index<F, Fields...>::value>();
+  }
+
+  // 第i个字段的首地址
+  T* field_data(size_t i) noexcept { return data_.data() + i * stride_; }
+  const T* field_data(size_t i) const noexcept { return data_.data() + i * stride_; }
+
+  // 全部字段一起改变形状 保留各字段原有的前min(新, 旧)个元素 新增元素置零
+  void reset_shape(const std::array<size_t, Rank>& dims) {
+    const size_t stride = field_stride(dims);
+    if (stride == stride_) {
+      const size_t old_size = size();
+      extents_ = dims;
+      for (size_t i = 0; i < field_count; ++i) {
+        if (size() > old_size) std::fill(field_data(i) + old_size, field_data(i) + size(), T(0));
+      }
+      return;
+    }
+    storage_type tmp(stride * field_count);
+    const size_t n = std::min(size(), calculate_size(dims));
+    for (size_t i = 0; i < field_count; ++i) {
+      std::copy_n(field_data(i), n, tmp.data() + i * stride);
+    }
+    data_ = std::move(tmp);
+    extents_ = dims;
+    stride_ = stride;
+  }
+
+  // 不保留原有元素也不初始化 容量足够时不重新分配
+  void reset_shape(const std::array<size_t, Rank>& dims, discard_t) {
+    extents_ = dims;
+    stride_ = field_stride(dims);
+    data_.resize(stride_ * field_count, discard);
+  }
+
+  std::array<size_t, Rank> extents() const noexcept { return extents_; }
+
+  size_t extent(size_t r) const { return extents_.at(r); }
+
+  // 单个字段的元素数
+  size_t size() const noexcept { return calculate_size(extents_); }
+
+  // 相邻字段首地址之间的元素数
+  size_t stride() const noexcept { return stride_; }
+
+  T* data() noexcept { return data_.data(); }
+  const T* data() const noexcept { return data_.data(); }
+
+  static size_t calculate_size(const std::array<size_t, Rank>& dims) noexcept {
+    size_t n = 1;
+    for (auto d : dims) n *= d;
+    return n;
+  }
+
+ private:
+  // 内联存储只对齐到simd包长 不用
+  using storage_type = dynamic_storage<T, auto_allocator<T>, 0>;
+
+  // 字段长度补齐到缓存行(同时也是simd包长)的整数倍
+  static size_t field_stride(const std::array<size_t, Rank>& dims) noexcept {
+    constexpr size_t line = cache_line_bytes / sizeof(T) > simd<T>::pack_size ? cache_line_bytes / sizeof(T)
+                                                                                 : simd<T>::pack_size;
+    return (calculate_size(dims) + line - 1) / line * line;
+  }
+
+  std::array<size_t, Rank> extents_{};
+  size_t stride_ = 0;
+  storage_type data_;
+};
+
+namespace detail {
+
+template <class T, size_t Rank, class Seq>
+struct soa_n_helper;
+
+template <class T, size_t Rank, size_t... I>
+struct soa_n_helper<T, Rank, std::index_sequence<I...>> {
+  using type = soa<T, Rank, field<I>...>;
+};
+
+}  // namespace detail
+
+// N个按序号访问的字段 例: md::soa_n<double, 1, 3> pos({n}); pos.get<0>()
+template <class T, size_t Rank, size_t N>
+using soa_n = typename detail::soa_n_helper<T, Rank, std::make_index_sequence<N>>::type;
+
+}  // namespace md
+
+#endif  // __MDVECTOR_SOA_H__
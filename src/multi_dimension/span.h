@@ -6,17 +6,20 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "expression_template/operator.h"
 #include "mdspan.h"
+#include "simd/simd_function.h"
 
 template <class T, size_t Rank, class Layout = md::layout_right, class Enable = void>
 class mdvector;
 
 namespace md {
 
+// 不拥有数据的视图 可以直接包装调用方的内存参与表达式计算 不拷贝
+// 例: md::span<double, 2> s(ptr, {rows, cols}); s = s * 2.0 + other;
+// 首地址按simd对齐时写入使用对齐指令 否则使用非对齐指令
 template <class T, size_t Rank, class Layout = md::layout_right>
 class span : public mdspan<T, Rank, Layout>, public md::tensor_expr<span<T, Rank, Layout>, T> {
-  using Policy = md::unaligned_policy;
-
  public:
   constexpr span() noexcept = default;
 
@@ -46,10 +49,15 @@ class span : public mdspan<T, Rank, Layout>, public md::tensor_expr<span<T, Rank
 
   template <class E>
   span& operator=(const md::tensor_expr<E, T>& expr) noexcept {
-    expr.eval_to<T, Policy>(this->data());
+    with_policy([&](auto policy) { expr.template eval_to<T, decltype(policy)>(this->data()); });
     return *this;
   }
 
+  template <class F>
+  void visit_data(F&& f) const noexcept {
+    f(this->data(), this->used_size());
+  }
+
   template <class T2>
   typename md::simd<T2>::type eval_simd(size_t i) const noexcept {
     return md::simd<T2>::loadu(this->data() + i);
@@ -61,66 +69,78 @@ class span : public mdspan<T, Rank, Layout>, public md::tensor_expr<span<T, Rank
   }
 
   span& operator+=(const span& other) noexcept {
-    simd_add_inplace<T, Policy>(this->data(), other.data(), this->used_size());
+    with_policy(other.data(), [&](auto policy) {
+      simd_add_inplace<T, decltype(policy)>(this->data(), other.data(), this->used_size());
+    });
     return *this;
   }
 
   span& operator-=(const span& other) noexcept {
-    simd_sub_inplace<T, Policy>(this->data(), other.data(), this->used_size());
+    with_policy(other.data(), [&](auto policy) {
+      simd_sub_inplace<T, decltype(policy)>(this->data(), other.data(), this->used_size());
+    });
     return *this;
   }
 
   span& operator*=(const span& other) noexcept {
-    simd_mul_inplace<T, Policy>(this->data(), other.data(), this->used_size());
+    with_policy(other.data(), [&](auto policy) {
+      simd_mul_inplace<T, decltype(policy)>(this->data(), other.data(), this->used_size());
+    });
     return *this;
   }
 
   span& operator/=(const span& other) noexcept {
-    simd_div_inplace<T, Policy>(this->data(), other.data(), this->used_size());
+    with_policy(other.data(), [&](auto policy) {
+      simd_div_inplace<T, decltype(policy)>(this->data(), other.data(), this->used_size());
+    });
     return *this;
   }
 
   template <class E>
   span& operator+=(const md::tensor_expr<E, T>& expr) noexcept {
-    (*this + expr).eval_to(this->data());
-    return *this;
+    return *this = *this + expr;
   }
 
   template <class E>
   span& operator-=(const md::tensor_expr<E, T>& expr) noexcept {
-    (*this - expr).eval_to(this->data());
-    return *this;
+    return *this = *this - expr;
   }
 
   template <class E>
   span& operator*=(const md::tensor_expr<E, T>& expr) noexcept {
-    (*this * expr).eval_to(this->data());
-    return *this;
+    return *this = *this * expr;
   }
 
   template <class E>
   span& operator/=(const md::tensor_expr<E, T>& expr) noexcept {
-    (*this / expr).eval_to(this->data());
-    return *this;
+    return *this = *this / expr;
   }
 
   span& operator+=(T scalar) noexcept {
-    md::simd_add_inplace_scalar<T, Policy>(this->data(), scalar, this->used_size());
+    with_policy([&](auto policy) {
+      md::simd_add_inplace_scalar<T, decltype(policy)>(this->data(), scalar, this->used_size());
+    });
     return *this;
   }
 
   span& operator-=(T scalar) noexcept {
-    md::simd_sub_inplace_scalar<T, Policy>(this->data(), scalar, this->used_size());
+    with_policy([&](auto policy) {
+      md::simd_sub_inplace_scalar<T, decltype(policy)>(this->data(), scalar, this->used_size());
+    });
     return *this;
   }
 
   span& operator*=(T scalar) noexcept {
-    md::simd_mul_inplace_scalar<T, Policy>(this->data(), scalar, this->used_size());
+    with_policy([&](auto policy) {
+      md::simd_mul_inplace_scalar<T, decltype(policy)>(this->data(), scalar, this->used_size());
+    });
     return *this;
   }
 
   span& operator/=(T scalar) noexcept {
-    md::simd_div_inplace_scalar<T, Policy>(this->data(), scalar, this->used_size());
+    with_policy([&](auto policy) {
+      md::simd_div_inplace_scalar<T, decltype(policy)>(this->data(), scalar, this->used_size());
+    });
     return *this;
   }
 
@@ -193,6 +213,20 @@ class span : public mdspan<T, Rank, Layout>, public md::tensor_expr<span<T, Rank
   return_type ln() const noexcept;
 
  private:
+  // 参与读写的地址都按simd对齐时使用aligned_policy
+  template <class F>
+  void with_policy(F&& f) const noexcept {
+    with_policy(this->data(), std::forward<F>(f));
+  }
+
+  template <class F>
+  void with_policy(const T* other, F&& f) const noexcept {
+    if (is_simd_aligned(this->data()) && is_simd_aligned(other)) {
+      f(aligned_policy{});
+    } else {
+      f(unaligned_policy{});
+    }
+  }
 };
 
 }  // namespace md
@@ -0,0 +1,262 @@
+#ifndef __MDVECTOR_STORAGE_H__
+#define __MDVECTOR_STORAGE_H__
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "detail.h"
+#include "parallel/thread_pool.h"
+#include "simd/allocator.h"
+
+// 小数组内联存储的字节数 补齐到simd包长后不超过该值的数组不在堆上分配
+#ifndef MDVECTOR_INLINE_BYTES
+#define MDVECTOR_INLINE_BYTES 64
+#endif
+
+namespace md {
+
+template <class T>
+constexpr size_t storage_alignment() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return simd<T>::alignment;
+  } else {
+    return alignof(T);
+  }
+}
+
+namespace detail {
+
+// 接管的外部内存 析构时调用deleter
+struct external_buffer {
+  virtual ~external_buffer() = default;
+};
+
+template <class T, class Deleter>
+struct external_buffer_impl final : external_buffer {
+  external_buffer_impl(T* p, Deleter d) : data(p), deleter(std::move(d)) {}
+  ~external_buffer_impl() override { deleter(data); }
+
+  T* data;
+  Deleter deleter;
+};
+
+}  // namespace detail
+
+// engine_dynamic的连续存储 仅用于trivial类型
+// 与std::vector不同: 可以只分配不初始化 也可以由线程池并行首次触碰
+// 小数组存放在对象内部(small buffer) 大数组在堆上 移动为O(1)
+// 也可以接管外部内存: 容量即外部元素数 超出时改为自行分配 原内存随即交还deleter
+template <class T, class Alloc = auto_allocator<T>, size_t InlineBytes = MDVECTOR_INLINE_BYTES>
+class dynamic_storage {
+ public:
+  static constexpr size_t inline_capacity = InlineBytes / sizeof(T);
+
+  dynamic_storage() noexcept = default;
+
+  explicit dynamic_storage(size_t n) : dynamic_storage(n, uninitialized) { zero_fill(0, n); }
+
+  dynamic_storage(size_t n, uninitialized_t) { allocate(n); }
+
+  dynamic_storage(size_t n, first_touch_t) {
+    allocate(n);
+    // 与parallel_assign相同的阈值: 低于阈值时之后的计算在当前线程进行 首次触碰也在当前线程
+    auto& pool = thread_pool::instance();
+    if (n < parallel_min_size || pool.size() == 1) {
+      zero_fill(0, n);
+      return;
+    }
+    pool.run([this, n, &pool](size_t part) {
+      const auto range = page_partition(data_, n, pool.size(), part);
+      zero_fill(range.first, range.second);
+    });
+  }
+
+  // 接管data开始的n个元素 不拷贝 释放时调用deleter(data)
+  template <class Deleter>
+  dynamic_storage(T* data, size_t n, adopt_t, Deleter deleter)
+      : external_(std::make_unique<detail::external_buffer_impl<T, Deleter>>(data, std::move(deleter))) {
+    data_ = data;
+    size_ = n;
+    capacity_ = n;
+  }
+
+  dynamic_storage(const dynamic_storage& other) : dynamic_storage(other.size_, uninitialized) {
+    copy_from(other.data_, other.size_);
+  }
+
+  dynamic_storage(dynamic_storage&& other) noexcept { steal(other); }
+
+  dynamic_storage& operator=(const dynamic_storage& other) {
+    if (this != &other) {
+      if (other.size_ > capacity_) {
+        dynamic_storage tmp(other);
+        swap(tmp);
+      } else {
+        size_ = other.size_;
+        copy_from(other.data_, other.size_);
+      }
+    }
+    return *this;
+  }
+
+  dynamic_storage& operator=(dynamic_storage&& other) noexcept {
+    if (this != &other) {
+      release();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~dynamic_storage() { release(); }
+
+  void swap(dynamic_storage& other) noexcept {
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(external_, other.external_);
+    } else {
+      dynamic_storage tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  // 保留原有元素 新增元素置零
+  void resize(size_t n) {
+    const size_t old = size_;
+    resize(n, uninitialized);
+    if (n > old) zero_fill(old, n);
+  }
+
+  // 保留原有元素 新增元素不初始化
+  void resize(size_t n, uninitialized_t) {
+    if (n > capacity_) {
+      reallocate(n);
+    }
+    size_ = n;
+  }
+
+  // 不保留原有元素 容量不足时先释放再分配 避免新旧内存同时存在
+  void resize(size_t n, discard_t) {
+    if (n > capacity_) {
+      release();
+      allocate(n);
+    }
+    size_ = n;
+  }
+
+  // 预留容量 保留原有元素
+  void reserve(size_t n) {
+    if (n > capacity_) {
+      reallocate(n);
+    }
+  }
+
+  // 释放多余容量 可放入内联存储时移回对象内部
+  void shrink_to_fit() {
+    if (is_inline() || capacity_ == size_) return;
+    if (size_ == 0) {
+      release();
+    } else {
+      reallocate(size_);
+    }
+  }
+
+  size_t capacity() const noexcept { return capacity_; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  T* begin() noexcept { return data_; }
+  T* end() noexcept { return data_ + size_; }
+  const T* begin() const noexcept { return data_; }
+  const T* end() const noexcept { return data_ + size_; }
+
+  // 数据是否存放在对象内部
+  bool is_inline() const noexcept { return data_ != nullptr && data_ == inline_data(); }
+
+  // 数据是否为接管的外部内存
+  bool is_adopted() const noexcept { return external_ != nullptr; }
+
+ private:
+  static size_t padded_size(size_t n) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      return (n + simd<T>::pack_size - 1) / simd<T>::pack_size * simd<T>::pack_size;
+    } else {
+      return n;
+    }
+  }
+
+  T* inline_data() noexcept { return reinterpret_cast<T*>(inline_); }
+  const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+  void allocate(size_t n) {
+    if (n > 0 && padded_size(n) <= inline_capacity) {
+      data_ = inline_data();
+      capacity_ = inline_capacity;
+    } else if (n > 0) {
+      data_ = Alloc().allocate(n);
+      capacity_ = n;
+    }
+    size_ = n;
+  }
+
+  // 分配容量为n的新内存并拷贝原有元素
+  void reallocate(size_t n) {
+    dynamic_storage tmp(n, uninitialized);
+    tmp.size_ = size_;
+    tmp.copy_from(data_, size_);
+    swap(tmp);
+  }
+
+  // 内联数据需要拷贝 堆数据直接接管指针
+  void steal(dynamic_storage& other) noexcept {
+    if (other.is_inline()) {
+      data_ = inline_data();
+      std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+    } else {
+      data_ = other.data_;
+      external_ = std::move(other.external_);
+    }
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+  }
+
+  void release() noexcept {
+    if (external_) {
+      external_.reset();
+    } else if (data_ && !is_inline()) {
+      Alloc().deallocate(data_, capacity_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+  void zero_fill(size_t begin, size_t end) noexcept {
+    if (end > begin) std::memset(static_cast<void*>(data_ + begin), 0, (end - begin) * sizeof(T));
+  }
+
+  void copy_from(const T* src, size_t n) noexcept {
+    if (n > 0) std::memcpy(static_cast<void*>(data_), src, n * sizeof(T));
+  }
+
+  T* data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  std::unique_ptr<detail::external_buffer> external_;
+  alignas(storage_alignment<T>()) unsigned char inline_[inline_capacity > 0 ? InlineBytes : 1];
+};
+
+}  // namespace md
+
+#endif  // __MDVECTOR_STORAGE_H__
@@ -0,0 +1,142 @@
+#ifndef __MDVECTOR_VEC3_H__
+#define __MDVECTOR_VEC3_H__
+
+#include "batch_kernel.h"
+
+namespace md {
+
+// 批量3维向量运算 数据为形状{3, n}的SoA: 第0/1/2行分别为x/y/z分量
+// 每个simd包内各分量只读一次 结果一次写出 不经过多个span表达式
+namespace vec3 {
+
+template <class T>
+inline batch::pack_t<T> dot(const batch::pack_array<T, 3>& a, const batch::pack_array<T, 3>& b) {
+  return simd<T>::fma(a[0], b[0], simd<T>::fma(a[1], b[1], simd<T>::mul(a[2], b[2])));
+}
+
+template <class T>
+inline batch::pack_array<T, 3> cross(const batch::pack_array<T, 3>& a, const batch::pack_array<T, 3>& b) {
+  using S = simd<T>;
+  return {S::sub(S::mul(a[1], b[2]), S::mul(a[2], b[1])), S::sub(S::mul(a[2], b[0]), S::mul(a[0], b[2])),
+          S::sub(S::mul(a[0], b[1]), S::mul(a[1], b[0]))};
+}
+
+// out(i) = a(:, i) . b(:, i)
+template <class T>
+void dot(const mdvector<T, 2>& a, const mdvector<T, 2>& b, mdvector<T, 1>& out) {
+  const auto ra = batch::component_rows<3>(a, "vec3::dot");
+  const auto rb = batch::component_rows<3>(b, "vec3::dot");
+  batch::check_count(a, b, "vec3::dot");
+  const size_t n = a.extent(1);
+  const auto res = batch::output_rows<1>(out, {n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto va = batch::load_components<F>(ra, i, rem);
+    const auto vb = batch::load_components<F>(rb, i, rem);
+    batch::store<F>(res[0] + i, rem, dot<T>(va, vb));
+  });
+}
+
+// out(:, i) = a(:, i) x b(:, i)
+template <class T>
+void cross(const mdvector<T, 2>& a, const mdvector<T, 2>& b, mdvector<T, 2>& out) {
+  const auto ra = batch::component_rows<3>(a, "vec3::cross");
+  const auto rb = batch::component_rows<3>(b, "vec3::cross");
+  batch::check_count(a, b, "vec3::cross");
+  const size_t n = a.extent(1);
+  const auto res = batch::output_rows<3>(out, {3, n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto c = cross<T>(batch::load_components<F>(ra, i, rem), batch::load_components<F>(rb, i, rem));
+    for (size_t k = 0; k < 3; ++k) batch::store<F>(res[k] + i, rem, c[k]);
+  });
+}
+
+// out(i) = |a(:, i)|
+template <class T>
+void norm(const mdvector<T, 2>& a, mdvector<T, 1>& out) {
+  const auto ra = batch::component_rows<3>(a, "vec3::norm");
+  const size_t n = a.extent(1);
+  const auto res = batch::output_rows<1>(out, {n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto v = batch::load_components<F>(ra, i, rem);
+    batch::store<F>(res[0] + i, rem, simd<T>::sqrt(dot<T>(v, v)));
+  });
+}
+
+// out(:, i) = a(:, i) / |a(:, i)| 乘以simd::rsqrt 零向量的结果为inf/nan
+// rsqrt默认为1 / sqrt 每个向量一次除法 定义MDVECTOR_FAST_RSQRT时改用硬件估计值加牛顿迭代 不做除法
+// out可以与a为同一对象
+template <class T>
+void normalize(const mdvector<T, 2>& a, mdvector<T, 2>& out) {
+  const auto ra = batch::component_rows<3>(a, "vec3::normalize");
+  const size_t n = a.extent(1);
+  const auto res = batch::output_rows<3>(out, {3, n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto v = batch::load_components<F>(ra, i, rem);
+    const auto r = simd<T>::rsqrt(dot<T>(v, v));
+    for (size_t k = 0; k < 3; ++k) batch::store<F>(res[k] + i, rem, simd<T>::mul(v[k], r));
+  });
+}
+
+// out(i) = |a(:, i) - b(:, i)|
+template <class T>
+void distance(const mdvector<T, 2>& a, const mdvector<T, 2>& b, mdvector<T, 1>& out) {
+  const auto ra = batch::component_rows<3>(a, "vec3::distance");
+  const auto rb = batch::component_rows<3>(b, "vec3::distance");
+  batch::check_count(a, b, "vec3::distance");
+  const size_t n = a.extent(1);
+  const auto res = batch::output_rows<1>(out, {n});
+  batch::for_each_pack<T>(n, [&](auto full, size_t i, size_t rem) {
+    constexpr bool F = decltype(full)::value;
+    const auto va = batch::load_components<F>(ra, i, rem);
+    const auto vb = batch::load_components<F>(rb, i, rem);
+    batch::pack_array<T, 3> d;
+    for (size_t k = 0; k < 3; ++k) d[k] = simd<T>::sub(va[k], vb[k]);
+    batch::store<F>(res[0] + i, rem, simd<T>::sqrt(dot<T>(d, d)));
+  });
+}
+
+// 返回新数组的版本
+template <class T>
+mdvector<T, 1> dot(const mdvector<T, 2>& a, const mdvector<T, 2>& b) {
+  mdvector<T, 1> res({a.extent(1)}, md::uninitialized);
+  dot(a, b, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> cross(const mdvector<T, 2>& a, const mdvector<T, 2>& b) {
+  mdvector<T, 2> res({3, a.extent(1)}, md::uninitialized);
+  cross(a, b, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 1> norm(const mdvector<T, 2>& a) {
+  mdvector<T, 1> res({a.extent(1)}, md::uninitialized);
+  norm(a, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 2> normalize(const mdvector<T, 2>& a) {
+  mdvector<T, 2> res({3, a.extent(1)}, md::uninitialized);
+  normalize(a, res);
+  return res;
+}
+
+template <class T>
+mdvector<T, 1> distance(const mdvector<T, 2>& a, const mdvector<T, 2>& b) {
+  mdvector<T, 1> res({a.extent(1)}, md::uninitialized);
+  distance(a, b, res);
+  return res;
+}
+
+}  // namespace vec3
+
+}  // namespace md
+
+#endif  // __MDVECTOR_VEC3_H__
@@ -0,0 +1,37 @@
+#ifndef __MDVECTOR_PARALLEL_EVAL_H__
+#define __MDVECTOR_PARALLEL_EVAL_H__
+
+#include <stdexcept>
+
+#include "mdvector.h"
+#include "parallel/thread_pool.h"
+
+namespace md {
+
+// 多线程计算表达式 按page_partition划分
+// 与first_touch构造使用相同划分 每个线程只访问自己首次触碰的内存页
+template <class T, size_t Rank, class Layout, class E>
+void parallel_assign(mdvector<T, Rank, Layout>& dest, const tensor_expr<E, T>& expr) {
+  const size_t n = dest.used_size();
+  if (expr.used_size() != n) {
+    throw std::runtime_error("parallel_assign: destination size does not match expression");
+  }
+
+  T* data = dest.begin();
+  auto& pool = thread_pool::instance();
+  if (n < parallel_min_size || pool.size() == 1) {
+    expr.template eval_to_range<T, aligned_policy>(data, 0, n);
+    return;
+  }
+
+  pool.run([&](size_t part) {
+    const auto range = page_partition(data, n, pool.size(), part);
+    if (range.first < range.second) {
+      expr.template eval_to_range<T, aligned_policy>(data, range.first, range.second);
+    }
+  });
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_PARALLEL_EVAL_H__
@@ -0,0 +1,143 @@
+#ifndef __MDVECTOR_PARALLEL_FOR_H__
+#define __MDVECTOR_PARALLEL_FOR_H__
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "multi_dimension/index_iterator.h"
+#include "parallel/thread_pool.h"
+#include "simd/allocator.h"
+
+namespace md {
+
+// 只给出维度时的划分粒度(元素数) 任意元素类型下都是缓存行的整数倍
+// 数组首地址按缓存行对齐时(simd_allocator保证) 各线程写入的缓存行互不相交
+inline constexpr size_t parallel_for_grain = cache_line_bytes;
+
+namespace detail {
+
+// 按内存顺序遍历线性偏移[begin, end) 每段为最内层维度上的连续一段
+// fn(index, offset, n): index为段首下标 offset为段首偏移 n为段长
+// 段首可以落在行中间 因此划分不必对齐到行
+template <size_t Rank, class Layout, class F>
+void for_each_segment(const std::array<size_t, Rank>& extents, const std::array<size_t, Rank>& strides, size_t begin,
+                      size_t end, F&& fn) {
+  constexpr size_t inner = index_iterator<Rank, Layout>::dim(0);
+  const size_t n = extents[inner];
+  if (begin >= end || n == 0) return;
+
+  std::array<size_t, Rank> index{};
+  size_t rest = begin;
+  for (size_t k = Rank; k-- > 0;) {
+    const size_t d = index_iterator<Rank, Layout>::dim(k);
+    index[d] = rest / strides[d];
+    rest %= strides[d];
+  }
+
+  for (size_t offset = begin; offset < end;) {
+    const size_t len = n - index[inner] < end - offset ? n - index[inner] : end - offset;
+    fn(static_cast<const std::array<size_t, Rank>&>(index), offset, len);
+    offset += len;
+    index[inner] += len;
+    if (index[inner] < n) break;
+    // 整行结束 向外层进位
+    index[inner] = 0;
+    for (size_t k = 1; k < Rank; ++k) {
+      const size_t d = index_iterator<Rank, Layout>::dim(k);
+      if (++index[d] < extents[d]) break;
+      index[d] = 0;
+    }
+  }
+}
+
+template <class F, size_t Rank, size_t... R>
+void invoke_index(F& fn, const std::array<size_t, Rank>& index, std::index_sequence<R...>) {
+  fn(index[R]...);
+}
+
+// 在线程池上执行 part_range(parts, part)给出每份的偏移范围 规模较小时串行
+template <class PartRange, class Body>
+void run_partitioned(size_t n, PartRange&& part_range, Body&& body) {
+  auto& pool = thread_pool::instance();
+  if (n < parallel_min_size || pool.size() == 1) {
+    body(size_t(0), n);
+    return;
+  }
+  pool.run([&](size_t part) {
+    const auto range = part_range(pool.size(), part);
+    if (range.first < range.second) body(range.first, range.second);
+  });
+}
+
+}  // namespace detail
+
+// 多线程遍历下标空间 fn(i, j, k, ...)
+// 按内存顺序连续划分 最外层维度不足线程数时同样均衡 分界为parallel_for_grain的整数倍
+// 例: md::parallel_for(v.extents(), [&](size_t i, size_t j) { v(i, j) = i + j; });
+template <class Layout = layout_right, size_t Rank, class F>
+void parallel_for(const std::array<size_t, Rank>& extents, F&& fn) {
+  const auto strides = compute_strides<Rank, Layout>(extents);
+  size_t n = 1;
+  for (size_t r = 0; r < Rank; ++r) n *= extents[r];
+
+  detail::run_partitioned(
+      n, [n](size_t parts, size_t part) { return static_partition(n, parts, part, parallel_for_grain); },
+      [&](size_t begin, size_t end) {
+        detail::for_each_segment<Rank, Layout>(
+            extents, strides, begin, end, [&fn](const std::array<size_t, Rank>& start, size_t, size_t len) {
+              constexpr size_t inner = index_iterator<Rank, Layout>::dim(0);
+              std::array<size_t, Rank> index = start;
+              for (size_t i = 0; i < len; ++i, ++index[inner]) {
+                detail::invoke_index(fn, index, std::make_index_sequence<Rank>{});
+              }
+            });
+      });
+}
+
+// 多线程逐行遍历 fn(index, row, n) row指向内存连续的一段 n为段长
+// 分界按数据地址对齐到缓存行 一行跨越分界时拆成两段分给相邻线程 不存在伪共享
+template <class T, size_t Rank, class Layout, class F>
+void parallel_for_rows(const index_space<T, Rank, Layout>& space, F&& fn) {
+  size_t n = 1;
+  for (size_t r = 0; r < Rank; ++r) n *= space.extents[r];
+
+  detail::run_partitioned(
+      n,
+      [&space, n](size_t parts, size_t part) {
+        return aligned_partition(space.data, n, parts, part, cache_line_bytes);
+      },
+      [&](size_t begin, size_t end) {
+        detail::for_each_segment<Rank, Layout>(
+            space.extents, space.strides, begin, end,
+            [&fn, &space](const std::array<size_t, Rank>& index, size_t offset, size_t len) {
+              fn(index, space.data + offset, len);
+            });
+      });
+}
+
+// 多线程遍历容器的下标 fn(i, j, k, ...) 划分方式同parallel_for_rows
+template <class T, size_t Rank, class Layout, class F>
+void parallel_for(const index_space<T, Rank, Layout>& space, F&& fn) {
+  constexpr size_t inner = index_iterator<Rank, Layout>::dim(0);
+  parallel_for_rows(space, [&fn](const std::array<size_t, Rank>& start, T*, size_t len) {
+    std::array<size_t, Rank> index = start;
+    for (size_t i = 0; i < len; ++i, ++index[inner]) {
+      detail::invoke_index(fn, index, std::make_index_sequence<Rank>{});
+    }
+  });
+}
+
+template <class V, class F, class = decltype(indices(std::declval<V&>()))>
+void parallel_for_rows(V&& v, F&& fn) {
+  parallel_for_rows(indices(v), std::forward<F>(fn));
+}
+
+template <class V, class F, class = decltype(indices(std::declval<V&>()))>
+void parallel_for(V&& v, F&& fn) {
+  parallel_for(indices(v), std::forward<F>(fn));
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_PARALLEL_FOR_H__
@@ -0,0 +1,188 @@
+#ifndef __MDVECTOR_THREAD_POOL_H__
+#define __MDVECTOR_THREAD_POOL_H__
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simd/huge_page.h"
+
+namespace md {
+
+// 固定线程池 第part份任务始终由同一个线程执行(part 0为调用线程)
+// 配合相同的划分方式 首次触碰与之后的计算落在同一线程上
+class thread_pool {
+ public:
+  // 线程数取环境变量MDVECTOR_NUM_THREADS 未设置时取硬件线程数
+  static thread_pool& instance() {
+    static thread_pool pool(default_threads());
+    return pool;
+  }
+
+  explicit thread_pool(size_t threads) {
+    for (size_t i = 1; i < threads; ++i) {
+      workers_.emplace_back([this, i] { worker(i); });
+    }
+  }
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  // 参与计算的线程数(含调用线程)
+  size_t size() const noexcept { return workers_.size() + 1; }
+
+  // 对part = 0..size()-1调用fn(part) 嵌套调用时在当前线程串行执行
+  template <class F>
+  void run(F&& fn) {
+    if (workers_.empty() || in_pool()) {
+      for (size_t part = 0; part < size(); ++part) {
+        fn(part);
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ctx_ = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+      invoke_ = [](void* ctx, size_t part) { (*static_cast<std::remove_reference_t<F>*>(ctx))(part); };
+      pending_ = workers_.size();
+      error_ = nullptr;
+      ++generation_;
+    }
+    cv_.notify_all();
+
+    in_pool() = true;
+    std::exception_ptr error;
+    try {
+      fn(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    in_pool() = false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    if (!error) error = error_;
+    lock.unlock();
+    if (error) std::rethrow_exception(error);
+  }
+
+ private:
+  static size_t default_threads() {
+    if (const char* env = std::getenv("MDVECTOR_NUM_THREADS")) {
+      const long n = std::strtol(env, nullptr, 10);
+      if (n > 0) return static_cast<size_t>(n);
+    }
+    const size_t n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+  }
+
+  static bool& in_pool() noexcept {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  void worker(size_t part) {
+    in_pool() = true;
+    size_t seen = 0;
+    for (;;) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      auto invoke = invoke_;
+      void* ctx = ctx_;
+      lock.unlock();
+
+      try {
+        invoke(ctx, part);
+      } catch (...) {
+        lock.lock();
+        if (!error_) error_ = std::current_exception();
+        lock.unlock();
+      }
+
+      lock.lock();
+      if (--pending_ == 0) {
+        done_cv_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  void (*invoke_)(void*, size_t) = nullptr;
+  void* ctx_ = nullptr;
+  size_t generation_ = 0;
+  size_t pending_ = 0;
+  std::exception_ptr error_;
+  bool stop_ = false;
+};
+
+// 将[0, n)按grain粒度均分为parts份 返回第part份的[begin, end)
+inline std::pair<size_t, size_t> static_partition(size_t n, size_t parts, size_t part, size_t grain = 1) {
+  const size_t blocks = (n + grain - 1) / grain;
+  const size_t base = blocks / parts;
+  const size_t rem = blocks % parts;
+  const size_t b = part * base + (part < rem ? part : rem);
+  const size_t e = b + base + (part < rem ? 1 : 0);
+  return {b * grain < n ? b * grain : n, e * grain < n ? e * grain : n};
+}
+
+// 小于该元素数时串行计算 唤醒线程池的开销大于收益
+inline constexpr size_t parallel_min_size = size_t(1) << 15;
+
+// 按地址划分 分界落在block_bytes对齐的地址上(缓存行或内存页) 相邻两份不共享同一块
+// data需满足simd对齐 此时各分界也是simd包长的整数倍
+template <class T>
+std::pair<size_t, size_t> aligned_partition(const T* data, size_t n, size_t parts, size_t part, size_t block_bytes) {
+  const size_t block_elems = block_bytes / sizeof(T) > 0 ? block_bytes / sizeof(T) : 1;
+
+  // 第一个对齐边界之前的部分归第0份
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(data);
+  size_t head = ((block_bytes - addr % block_bytes) % block_bytes) / sizeof(T);
+  if (head > n) head = n;
+
+  auto range = static_partition(n - head, parts, part, block_elems);
+  range.first = part == 0 ? 0 : range.first + head;
+  range.second += head;
+  return range;
+}
+
+// 按内存页划分 保证每页只被一个线程首次触碰
+template <class T>
+std::pair<size_t, size_t> page_partition(const T* data, size_t n, size_t parts, size_t part) {
+  size_t page = 4096;
+  const huge_page_config& config = huge_pages();
+  if (config.mode.load(std::memory_order_relaxed) != huge_page_mode::none &&
+      n * sizeof(T) >= config.threshold_bytes.load(std::memory_order_relaxed)) {
+    const size_t huge = config.page_bytes.load(std::memory_order_relaxed);
+    if (huge > 0) page = huge;
+  }
+  return aligned_partition(data, n, parts, part, page);
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_THREAD_POOL_H__
@@ -4,10 +4,15 @@
 #include <limits>
 #include <memory>
 
+#include "huge_page.h"
+#include "scratch_arena.h"
 #include "simd_base.h"
 
 namespace md {
 
+// 缓存行大小 堆上分配至少按此对齐 便于多线程按缓存行划分
+inline constexpr size_t cache_line_bytes = 64;
+
 template <class T>
 class simd_allocator {
  public:
@@ -30,18 +35,38 @@ class simd_allocator {
     if (n > max_size()) {
       throw std::bad_alloc();
     }
+    // 优先使用当前线程激活的scratch_arena
+    if (scratch_arena* arena = scratch_arena::active()) {
+      if (void* p = arena->allocate(n * sizeof(T), alignment_for())) {
+        return static_cast<T*>(p);
+      }
+    }
+    // 大数组使用大页
+    if (void* p = huge_page_allocate(n * sizeof(T))) {
+      return static_cast<T*>(p);
+    }
+    // aligned_alloc要求大小为对齐值的整数倍
+    const size_t alignment = alignment_for() > cache_line_bytes ? alignment_for() : cache_line_bytes;
+    const size_t bytes = (n * sizeof(T) + alignment - 1) / alignment * alignment;
     void* ptr =
 #ifdef _WIN32
-        _aligned_malloc(n * sizeof(T), alignment_for());
+        _aligned_malloc(bytes, alignment);
 #else
-        aligned_alloc(alignment_for(), n * sizeof(T));
+        aligned_alloc(alignment, bytes);
 #endif
     if (!ptr) throw std::bad_alloc();
     return static_cast<T*>(ptr);
   }
 
-  void deallocate(T* p, size_t _ = 0) noexcept {
+  void deallocate(T* p, size_t = 0) noexcept {
     if (p) {
+      // arena上的内存可能来自其他线程或已结束的作用域 统一交给所属的arena
+      if (scratch_arena::release(p)) {
+        return;
+      }
+      if (huge_page_deallocate(p)) {
+        return;
+      }
 #ifdef _WIN32
       _aligned_free(p);
 #else
@@ -30,6 +30,21 @@ struct simd<float> {
     return vmulq_f32(a, recp);
   }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return vfmaq_f32(c, a, b); }
+  static inline type sqrt(const_ref_type a) { return vsqrtq_f32(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值加两次牛顿迭代 否则为精确结果
+  // vrsqrte只有约8位精度 一次迭代约16位 两次后相对误差为几个ulp
+  static inline type rsqrt(const_ref_type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    type y = vrsqrteq_f32(a);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+    return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+#else
+    return div(set1(1.0f), sqrt(a));
+#endif
+  }
+
   static inline type mask_load(const float* p, const size_t& remaining) {
     static const uint32_t mask_pattern[4] = {0, 0, 0, 0};
     uint32x4_t mask = vcltq_u32(vld1q_u32(mask_pattern), vdupq_n_u32(remaining));
@@ -57,6 +72,42 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return vdupq_n_f32(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理4条记录 2/3/4分量使用结构化加载/存储
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const float32x4x2_t r = vld2q_f32(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+    } else if constexpr (N == 3) {
+      const float32x4x3_t r = vld3q_f32(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+      storeu(rows[2] + i, r.val[2]);
+    } else if constexpr (N == 4) {
+      const float32x4x4_t r = vld4q_f32(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+      storeu(rows[2] + i, r.val[2]);
+      storeu(rows[3] + i, r.val[3]);
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    if constexpr (N == 2) {
+      vst2q_f32(aos, float32x4x2_t{{loadu(rows[0] + i), loadu(rows[1] + i)}});
+    } else if constexpr (N == 3) {
+      vst3q_f32(aos, float32x4x3_t{{loadu(rows[0] + i), loadu(rows[1] + i), loadu(rows[2] + i)}});
+    } else if constexpr (N == 4) {
+      vst4q_f32(aos, float32x4x4_t{{loadu(rows[0] + i), loadu(rows[1] + i), loadu(rows[2] + i), loadu(rows[3] + i)}});
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 
 template <>
@@ -83,6 +134,22 @@ struct simd<double> {
     return vmulq_f64(a, recp);
   }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return vfmaq_f64(c, a, b); }
+  static inline type sqrt(const_ref_type a) { return vsqrtq_f64(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值加三次牛顿迭代 否则为精确结果
+  // 估计值约8位 每次迭代精度翻倍 三次后为几个ulp
+  static inline type rsqrt(const_ref_type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    type y = vrsqrteq_f64(a);
+    y = vmulq_f64(y, vrsqrtsq_f64(vmulq_f64(a, y), y));
+    y = vmulq_f64(y, vrsqrtsq_f64(vmulq_f64(a, y), y));
+    return vmulq_f64(y, vrsqrtsq_f64(vmulq_f64(a, y), y));
+#else
+    return div(set1(1.0), sqrt(a));
+#endif
+  }
+
   static inline type mask_load(const double* p, const size_t& remaining) {
     static const uint64_t mask_pattern[2] = {0, 0};
     uint64x2_t mask = vcltq_u64(vld1q_u64(mask_pattern), vdupq_n_u64(remaining));
@@ -110,5 +177,41 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return vdupq_n_f64(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理2条记录 2/3/4分量使用结构化加载/存储
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const float64x2x2_t r = vld2q_f64(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+    } else if constexpr (N == 3) {
+      const float64x2x3_t r = vld3q_f64(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+      storeu(rows[2] + i, r.val[2]);
+    } else if constexpr (N == 4) {
+      const float64x2x4_t r = vld4q_f64(aos);
+      storeu(rows[0] + i, r.val[0]);
+      storeu(rows[1] + i, r.val[1]);
+      storeu(rows[2] + i, r.val[2]);
+      storeu(rows[3] + i, r.val[3]);
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    if constexpr (N == 2) {
+      vst2q_f64(aos, float64x2x2_t{{loadu(rows[0] + i), loadu(rows[1] + i)}});
+    } else if constexpr (N == 3) {
+      vst3q_f64(aos, float64x2x3_t{{loadu(rows[0] + i), loadu(rows[1] + i), loadu(rows[2] + i)}});
+    } else if constexpr (N == 4) {
+      vst4q_f64(aos, float64x2x4_t{{loadu(rows[0] + i), loadu(rows[1] + i), loadu(rows[2] + i), loadu(rows[3] + i)}});
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 #endif  // __ARM_NEON_H__
\ No newline at end of file
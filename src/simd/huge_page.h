@@ -0,0 +1,147 @@
+#ifndef __MDVECTOR_HUGE_PAGE_H__
+#define __MDVECTOR_HUGE_PAGE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace md {
+
+enum class huge_page_mode {
+  none,         // 全部使用aligned_alloc
+  transparent,  // mmap按大页对齐 + madvise(MADV_HUGEPAGE)
+  hugetlb,      // MAP_HUGETLB 需要预留大页 失败时回退到transparent
+};
+
+// 各字段为原子变量 分配可能发生在线程池的工作线程上 修改与读取不构成数据竞争
+// 每次分配各字段只读取一次 修改只影响之后的分配
+struct huge_page_config {
+  std::atomic<huge_page_mode> mode{huge_page_mode::none};
+  std::atomic<size_t> threshold_bytes{size_t(4) << 20};  // 小于该值的分配不使用大页
+  std::atomic<size_t> page_bytes{size_t(2) << 20};       // 大页大小
+};
+
+// 全局配置 通常在分配大数组之前设置
+inline huge_page_config& huge_pages() noexcept {
+  static huge_page_config config;
+  return config;
+}
+
+// 记录通过mmap分配的内存块 释放时据此选择munmap
+class huge_page_registry {
+ public:
+  static huge_page_registry& instance() noexcept {
+    static huge_page_registry registry;
+    return registry;
+  }
+
+  void add(void* p, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocks_.emplace(p, bytes);
+    count_.fetch_add(1, std::memory_order_release);
+  }
+
+  // 返回块大小 不存在时返回0
+  size_t remove(void* p) noexcept {
+    // 没有大页块时无需加锁
+    if (count_.load(std::memory_order_acquire) == 0) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = blocks_.find(p);
+    if (it == blocks_.end()) return 0;
+    const size_t bytes = it->second;
+    blocks_.erase(it);
+    count_.fetch_sub(1, std::memory_order_release);
+    return bytes;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<void*, size_t> blocks_;
+  std::atomic<size_t> count_{0};
+};
+
+// 不满足阈值或分配失败时返回nullptr 由调用方回退到aligned_alloc
+inline void* huge_page_allocate(size_t bytes) noexcept {
+#ifdef _WIN32
+  (void)bytes;
+  return nullptr;
+#else
+  const huge_page_mode mode = huge_pages().mode.load(std::memory_order_relaxed);
+  const size_t threshold_bytes = huge_pages().threshold_bytes.load(std::memory_order_relaxed);
+  const size_t page_bytes = huge_pages().page_bytes.load(std::memory_order_relaxed);
+  if (mode == huge_page_mode::none || bytes < threshold_bytes || page_bytes == 0) {
+    return nullptr;
+  }
+  const size_t len = (bytes + page_bytes - 1) / page_bytes * page_bytes;
+
+#ifdef MAP_HUGETLB
+  if (mode == huge_page_mode::hugetlb) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+    if (page_bytes == (size_t(2) << 20)) flags |= MAP_HUGE_2MB;
+#endif
+#ifdef MAP_HUGE_1GB
+    if (page_bytes == (size_t(1) << 30)) flags |= MAP_HUGE_1GB;
+#endif
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p != MAP_FAILED) {
+      try {
+        huge_page_registry::instance().add(p, len);
+      } catch (...) {
+        ::munmap(p, len);
+        return nullptr;
+      }
+      return p;
+    }
+  }
+#endif
+
+  // 多映射一个大页 裁掉首尾得到大页对齐的区间
+  const size_t raw_len = len + page_bytes;
+  void* raw = ::mmap(nullptr, raw_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const uintptr_t raw_addr = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t addr = (raw_addr + page_bytes - 1) / page_bytes * page_bytes;
+  const size_t head = addr - raw_addr;
+  const size_t tail = raw_len - head - len;
+  if (head > 0) ::munmap(raw, head);
+  if (tail > 0) ::munmap(reinterpret_cast<void*>(addr + len), tail);
+
+  void* p = reinterpret_cast<void*>(addr);
+#ifdef MADV_HUGEPAGE
+  ::madvise(p, len, MADV_HUGEPAGE);
+#endif
+  try {
+    huge_page_registry::instance().add(p, len);
+  } catch (...) {
+    ::munmap(p, len);
+    return nullptr;
+  }
+  return p;
+#endif
+}
+
+// p不是大页块时返回false
+inline bool huge_page_deallocate(void* p) noexcept {
+#ifdef _WIN32
+  (void)p;
+  return false;
+#else
+  const size_t len = huge_page_registry::instance().remove(p);
+  if (len == 0) return false;
+  ::munmap(p, len);
+  return true;
+#endif
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_HUGE_PAGE_H__
@@ -1,6 +1,8 @@
 #ifndef __MDVECTOR_NONE_SIMD_H__
 #define __MDVECTOR_NONE_SIMD_H__
 
+#include <cmath>
+
 #include "simd_base.h"
 
 // ======================== NO SIMD ========================
@@ -27,6 +29,11 @@ struct simd<float> {
   static inline type mul(const_ref_type a, const_ref_type b) { return a * b; }
   static inline type div(const_ref_type a, const_ref_type b) { return a / b; }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return a * b + c; }
+  static inline type sqrt(const_ref_type a) { return std::sqrt(a); }
+  static inline type rsqrt(const_ref_type a) { return div(set1(1.0f), sqrt(a)); }
+
   static inline type mask_load(const float* p, const size_t& remaining) { return *p; }
   static inline void mask_store(float* p, const size_t& remaining, const_ref_type v) { *p = v; }
 
@@ -34,6 +41,16 @@ struct simd<float> {
   static inline void mask_storeu(float* p, const size_t& remaining, const_ref_type v) { *p = v; }
 
   static inline type set1(float val) { return val; }
+
+  // 交错存放的N分量记录与N行互转 每次处理pack_size条记录
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    deinterleave_scalar<N, pack_size>(aos, rows, i);
+  }
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    interleave_scalar<N, pack_size>(rows, aos, i);
+  }
 };
 
 template <>
@@ -56,6 +73,11 @@ struct simd<double> {
   static inline type mul(const_ref_type a, const_ref_type b) { return a * b; }
   static inline type div(const_ref_type a, const_ref_type b) { return a / b; }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return a * b + c; }
+  static inline type sqrt(const_ref_type a) { return std::sqrt(a); }
+  static inline type rsqrt(const_ref_type a) { return div(set1(1.0), sqrt(a)); }
+
   static inline type mask_load(const double* p, const size_t& remaining) { return *p; }
   static inline void mask_store(double* p, const size_t& remaining, const_ref_type v) { *p = v; }
 
@@ -63,6 +85,16 @@ struct simd<double> {
   static inline void mask_storeu(double* p, const size_t& remaining, const_ref_type v) { *p = v; }
 
   static inline type set1(type val) { return val; }
+
+  // 交错存放的N分量记录与N行互转 每次处理pack_size条记录
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    deinterleave_scalar<N, pack_size>(aos, rows, i);
+  }
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    interleave_scalar<N, pack_size>(rows, aos, i);
+  }
 };
 
 }  // namespace md
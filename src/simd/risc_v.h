@@ -24,6 +24,11 @@ struct simd<float> {
   static inline type mul(const_ref_type a, const_ref_type b) { return vfmul_vv_f32m1(a, b, pack_size); }
   static inline type div(const_ref_type a, const_ref_type b) { return vfdiv_vv_f32m1(a, b, pack_size); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return vfmadd_vv_f32m1(a, b, c, pack_size); }
+  static inline type sqrt(const_ref_type a) { return vfsqrt_v_f32m1(a, pack_size); }
+  static inline type rsqrt(const_ref_type a) { return div(set1(1.0f), sqrt(a)); }
+
   static inline type mask_load(const float* p, const size_t& remaining) {
     vbool32_t mask = vmset_m_b32(remaining, pack_size);
     return vle32_v_f32m1_m(mask, vundefined_f32m1(), p, pack_size);
@@ -34,6 +39,16 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return vfmv_v_f_f32m1(val, pack_size); }
+
+  // 交错存放的N分量记录与N行互转 每次处理pack_size条记录
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    deinterleave_scalar<N, pack_size>(aos, rows, i);
+  }
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    interleave_scalar<N, pack_size>(rows, aos, i);
+  }
 };
 
 template <>
@@ -53,6 +68,11 @@ struct simd<double> {
   static inline type mul(const_ref_type a, const_ref_type b) { return vfmul_vv_f64m1(a, b, pack_size); }
   static inline type div(const_ref_type a, const_ref_type b) { return vfdiv_vv_f64m1(a, b, pack_size); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return vfmadd_vv_f64m1(a, b, c, pack_size); }
+  static inline type sqrt(const_ref_type a) { return vfsqrt_v_f64m1(a, pack_size); }
+  static inline type rsqrt(const_ref_type a) { return div(set1(1.0), sqrt(a)); }
+
   static inline type mask_load(const double* p, const size_t& remaining) {
     vbool64_t mask = vmset_m_b64(remaining, pack_size);
     return vle64_v_f64m1_m(mask, vundefined_f64m1(), p, pack_size);
@@ -63,6 +83,16 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return vfmv_v_f_f64m1(val, pack_size); }
+
+  // 交错存放的N分量记录与N行互转 每次处理pack_size条记录
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    deinterleave_scalar<N, pack_size>(aos, rows, i);
+  }
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    interleave_scalar<N, pack_size>(rows, aos, i);
+  }
 };
 
 }  // namespace md
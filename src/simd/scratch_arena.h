@@ -0,0 +1,342 @@
+#ifndef __MDVECTOR_SCRATCH_ARENA_H__
+#define __MDVECTOR_SCRATCH_ARENA_H__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace md {
+
+class scratch_arena;
+
+namespace detail {
+
+// arena的内存块与分配记录 分配在堆上 arena析构时仍有未释放的分配则保留到最后一次释放
+// 记录每个未释放分配的区间 回退时不越过仍在使用的分配 因此逃出作用域的内存不会被复用
+// arena同一时刻只在一个线程上激活 top/peak/live由该线程直接读写 不加锁
+// 其他线程或作用域外的释放记入pending(加锁) 由激活arena的线程在回退或查询用量时处理
+// arena析构后没有所属线程 全部操作在锁内进行
+struct arena_block {
+  char* base = nullptr;
+  size_t capacity = 0;
+  size_t top = 0;
+  size_t peak = 0;
+  // 按起点升序的未释放分配[起点, 终点) 新分配总在top之后 追加即保持有序
+  std::vector<std::pair<size_t, size_t>> live;
+  // 待处理的释放(分配起点)
+  std::vector<size_t> pending;
+  std::atomic<size_t> pending_count{0};
+  // 所属arena 析构后为nullptr
+  scratch_arena* arena = nullptr;
+  // 在arena_registry中的槽位
+  size_t slot = 0;
+  std::mutex mutex;
+
+  bool owns(const void* p) const noexcept {
+    const char* c = static_cast<const char*>(p);
+    return c >= base && c < base + capacity;
+  }
+
+  // 仍在使用的分配的最高终点 不能回退到其之下
+  size_t live_end() const noexcept { return live.empty() ? 0 : live.back().second; }
+
+  void release(size_t offset) noexcept {
+    auto it = std::lower_bound(live.begin(), live.end(), std::make_pair(offset, size_t(0)));
+    if (it == live.end() || it->first != offset) return;
+    // 释放的是最后一次分配时立即回收(后进先出)
+    if (it->second == top) top = offset;
+    live.erase(it);
+    top = std::max(top, live_end());
+  }
+
+  // 调用方持有mutex
+  void drain_locked() noexcept {
+    for (size_t offset : pending) release(offset);
+    pending.clear();
+    pending_count.store(0, std::memory_order_relaxed);
+  }
+
+  // 所属线程处理pending 没有待处理的释放时不加锁
+  void drain() noexcept {
+    if (pending_count.load(std::memory_order_acquire) == 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    drain_locked();
+  }
+};
+
+inline void free_arena_memory(char* p) noexcept {
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
+// 全部arena的内存块 任意线程释放时据此找到所属的块
+// 各块的地址区间发布在固定槽位的原子变量中: 不属于任何arena的指针(普通堆内存)不加锁即可排除
+// 槽位用完后新的块不进槽位 此后排除前总要加锁
+class arena_registry {
+ public:
+  static constexpr size_t max_slots = 32;
+
+  static arena_registry& instance() noexcept {
+    static arena_registry registry;
+    return registry;
+  }
+
+  void add(arena_block* block) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocks_.push_back(block);
+    block->slot = max_slots;
+    for (size_t i = 0; i < max_slots; ++i) {
+      if (slot_block_[i]) continue;
+      slot_block_[i] = block;
+      block->slot = i;
+      begin_[i].store(reinterpret_cast<uintptr_t>(block->base), std::memory_order_release);
+      end_[i].store(reinterpret_cast<uintptr_t>(block->base) + block->capacity, std::memory_order_release);
+      if (i >= used_.load(std::memory_order_relaxed)) used_.store(i + 1, std::memory_order_release);
+      return;
+    }
+    overflow_.fetch_add(1, std::memory_order_release);
+  }
+
+  // arena析构 没有未释放的分配时立即回收 否则由最后一次释放回收
+  void retire(arena_block* block) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool empty = false;
+    {
+      std::lock_guard<std::mutex> block_lock(block->mutex);
+      block->drain_locked();
+      block->arena = nullptr;
+      empty = block->live.empty();
+    }
+    if (empty) erase(block);
+  }
+
+  // p不属于任何arena时返回false 普通堆内存不加锁
+  bool release(const void* p) noexcept {
+    if (!may_own(p)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    arena_block* block = find_locked(p);
+    if (!block) return false;
+    bool retired_empty = false;
+    {
+      std::lock_guard<std::mutex> block_lock(block->mutex);
+      const size_t offset = size_t(static_cast<const char*>(p) - block->base);
+      if (block->arena) {
+        // arena仍在 交给所属线程处理 记录失败时该分配保留到arena析构
+        try {
+          block->pending.push_back(offset);
+          block->pending_count.fetch_add(1, std::memory_order_release);
+        } catch (...) {
+        }
+      } else {
+        block->release(offset);
+        retired_empty = block->live.empty();
+      }
+    }
+    if (retired_empty) erase(block);
+    return true;
+  }
+
+  scratch_arena* owner(const void* p) noexcept {
+    if (!may_own(p)) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    arena_block* block = find_locked(p);
+    if (!block) return nullptr;
+    std::lock_guard<std::mutex> block_lock(block->mutex);
+    return block->arena;
+  }
+
+ private:
+  // 只比较地址区间 可能误判为属于(随后加锁确认) 不会漏判
+  bool may_own(const void* p) const noexcept {
+    if (overflow_.load(std::memory_order_acquire) != 0) return true;
+    const uintptr_t c = reinterpret_cast<uintptr_t>(p);
+    const size_t n = used_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; ++i) {
+      if (c >= begin_[i].load(std::memory_order_acquire) && c < end_[i].load(std::memory_order_acquire)) return true;
+    }
+    return false;
+  }
+
+  arena_block* find_locked(const void* p) const noexcept {
+    for (arena_block* block : blocks_) {
+      if (block->owns(p)) return block;
+    }
+    return nullptr;
+  }
+
+  void erase(arena_block* block) noexcept {
+    blocks_.erase(std::find(blocks_.begin(), blocks_.end(), block));
+    if (block->slot < max_slots) {
+      const size_t i = block->slot;
+      end_[i].store(0, std::memory_order_release);
+      begin_[i].store(0, std::memory_order_release);
+      slot_block_[i] = nullptr;
+      size_t n = used_.load(std::memory_order_relaxed);
+      while (n > 0 && !slot_block_[n - 1]) --n;
+      used_.store(n, std::memory_order_release);
+    } else {
+      overflow_.fetch_sub(1, std::memory_order_release);
+    }
+    free_arena_memory(block->base);
+    delete block;
+  }
+
+  std::mutex mutex_;
+  std::vector<arena_block*> blocks_;
+  arena_block* slot_block_[max_slots] = {};
+  std::atomic<uintptr_t> begin_[max_slots] = {};
+  std::atomic<uintptr_t> end_[max_slots] = {};
+  std::atomic<size_t> used_{0};
+  std::atomic<size_t> overflow_{0};
+};
+
+}  // namespace detail
+
+// 线性(bump pointer)分配器 用于时间步内的临时变量
+// 通过scratch_scope激活后 当前线程上的simd_allocator优先从arena分配 作用域结束时整体回退
+// 同一个arena同一时刻只能在一个线程上激活 激活线程上的分配与释放不加锁
+// 任意线程都可以释放arena上的内存 作用域或arena结束后才释放也是安全的 这类释放需要加锁
+// 作用域内重新分配或移出作用域的mdvector仍然有效 其内存在释放前不会被回退复用 只是在此之前占用arena空间
+class scratch_arena {
+ public:
+  static constexpr size_t block_alignment = 64;
+
+  explicit scratch_arena(size_t capacity_bytes) : block_(new detail::arena_block) {
+    block_->capacity = round_up(capacity_bytes, block_alignment);
+    if (block_->capacity > 0) {
+#ifdef _WIN32
+      block_->base = static_cast<char*>(_aligned_malloc(block_->capacity, block_alignment));
+#else
+      block_->base = static_cast<char*>(aligned_alloc(block_alignment, block_->capacity));
+#endif
+      if (!block_->base) {
+        delete block_;
+        throw std::bad_alloc();
+      }
+    }
+    block_->arena = this;
+    try {
+      detail::arena_registry::instance().add(block_);
+    } catch (...) {
+      detail::free_arena_memory(block_->base);
+      delete block_;
+      throw;
+    }
+  }
+
+  ~scratch_arena() {
+    if (active_arena() == this) {
+      active_arena() = nullptr;
+    }
+    detail::arena_registry::instance().retire(block_);
+  }
+
+  scratch_arena(const scratch_arena&) = delete;
+  scratch_arena& operator=(const scratch_arena&) = delete;
+
+  // 空间不足时返回nullptr 由调用方回退到堆分配
+  void* allocate(size_t bytes, size_t alignment) noexcept {
+    // 每个分配至少占1字节 保证起点互不相同
+    if (bytes == 0) bytes = 1;
+    const size_t start = round_up(block_->top, alignment);
+    if (start + bytes > block_->capacity || start + bytes < start) {
+      return nullptr;
+    }
+    try {
+      block_->live.emplace_back(start, start + bytes);
+    } catch (...) {
+      return nullptr;
+    }
+    block_->top = start + bytes;
+    if (block_->top > block_->peak) block_->peak = block_->top;
+    return block_->base + start;
+  }
+
+  bool owns(const void* p) const noexcept { return block_->owns(p); }
+
+  size_t mark() const noexcept {
+    block_->drain();
+    return block_->top;
+  }
+
+  // 回退到mark 但不越过仍在使用的分配
+  void reset(size_t mark = 0) noexcept {
+    block_->drain();
+    if (mark < block_->top) block_->top = std::max(mark, block_->live_end());
+  }
+
+  size_t used() const noexcept { return mark(); }
+
+  size_t peak() const noexcept { return block_->peak; }
+
+  size_t capacity() const noexcept { return block_->capacity; }
+
+  // 当前线程激活的arena
+  static scratch_arena* active() noexcept { return active_arena(); }
+
+  // 拥有p的arena 可在任意线程查询 已析构或不属于任何arena时返回nullptr
+  static scratch_arena* owner(const void* p) noexcept { return detail::arena_registry::instance().owner(p); }
+
+  // 释放arena上的内存 p属于某个arena(包括已析构但仍有未释放分配的arena)时返回true 否则返回false
+  // p属于当前线程激活的arena时直接回收 不加锁 不属于任何arena时只比较地址区间 也不加锁
+  static bool release(const void* p) noexcept {
+    scratch_arena* arena = active_arena();
+    if (arena && arena->owns(p)) {
+      arena->block_->release(size_t(static_cast<const char*>(p) - arena->block_->base));
+      return true;
+    }
+    return detail::arena_registry::instance().release(p);
+  }
+
+ private:
+  friend class scratch_scope;
+
+  static size_t round_up(size_t n, size_t alignment) noexcept { return (n + alignment - 1) / alignment * alignment; }
+
+  static scratch_arena*& active_arena() noexcept {
+    static thread_local scratch_arena* active = nullptr;
+    return active;
+  }
+
+  detail::arena_block* block_;
+};
+
+// 作用域内激活arena 析构时回退到进入时的位置并恢复之前的arena
+// 传入nullptr可在作用域内暂停arena(例如创建需要长期保留的结果)
+class scratch_scope {
+ public:
+  explicit scratch_scope(scratch_arena& arena) noexcept
+      : arena_(&arena), mark_(arena.mark()), prev_(scratch_arena::active_arena()) {
+    scratch_arena::active_arena() = arena_;
+  }
+
+  explicit scratch_scope(std::nullptr_t) noexcept : prev_(scratch_arena::active_arena()) {
+    scratch_arena::active_arena() = nullptr;
+  }
+
+  ~scratch_scope() {
+    if (arena_) arena_->reset(mark_);
+    scratch_arena::active_arena() = prev_;
+  }
+
+  scratch_scope(const scratch_scope&) = delete;
+  scratch_scope& operator=(const scratch_scope&) = delete;
+
+ private:
+  scratch_arena* arena_ = nullptr;
+  size_t mark_ = 0;
+  scratch_arena* prev_ = nullptr;
+};
+
+}  // namespace md
+
+#endif  // __MDVECTOR_SCRATCH_ARENA_H__
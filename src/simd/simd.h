@@ -1,6 +1,9 @@
 #ifndef __MDVECTOR_SIMD_H__
 #define __MDVECTOR_SIMD_H__
 
+#include <cstdint>
+#include <iostream>
+
 #if defined(__x86_64__) || defined(_M_X64) || defined(_M_IX86) || defined(_M_AMD64)
 #if defined(__AVX512F__)
 #include "x86_avx512.h"
@@ -41,6 +44,12 @@ void print_simd_type() {
 #endif
 }
 
+// 地址满足simd<T>::load/store的对齐要求
+template <class T>
+inline bool is_simd_aligned(const T* p) noexcept {
+  return reinterpret_cast<uintptr_t>(p) % simd<T>::alignment == 0;
+}
+
 // 对齐
 struct aligned_policy {
   template <class T>
@@ -1,11 +1,33 @@
 #ifndef __MDVECTOR_SIMD_BASE_H__
 #define __MDVECTOR_SIMD_BASE_H__
 
+#include <cstddef>
+
 namespace md {
 
 template <class T>
 struct simd;
 
+// 交错存放的N分量记录(AoS)与N行(SoA)互转的逐元素实现 后端没有专用shuffle序列时使用
+// aos指向第i条记录 rows[c]为第c个分量所在行 处理P条记录
+template <size_t N, size_t P, class T>
+inline void deinterleave_scalar(const T* aos, T* const* rows, size_t i) {
+  for (size_t k = 0; k < P; ++k) {
+    for (size_t c = 0; c < N; ++c) {
+      rows[c][i + k] = aos[k * N + c];
+    }
+  }
+}
+
+template <size_t N, size_t P, class T>
+inline void interleave_scalar(const T* const* rows, T* aos, size_t i) {
+  for (size_t k = 0; k < P; ++k) {
+    for (size_t c = 0; c < N; ++c) {
+      aos[k * N + c] = rows[c][i + k];
+    }
+  }
+}
+
 }  // namespace md
 
 #endif  // __SIMD_BASE_H__
\ No newline at end of file
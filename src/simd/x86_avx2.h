@@ -27,6 +27,26 @@ struct simd<float> {
   static inline type mul(const_ref_type a, const_ref_type b) { return _mm256_mul_ps(a, b); }
   static inline type div(const_ref_type a, const_ref_type b) { return _mm256_div_ps(a, b); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) {
+#ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+  static inline type sqrt(const_ref_type a) { return _mm256_sqrt_ps(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值加一次牛顿迭代 否则为精确结果
+  static inline type rsqrt(const_ref_type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    const type y = _mm256_rsqrt_ps(a);
+    const type h = _mm256_mul_ps(_mm256_mul_ps(set1(0.5f), a), _mm256_mul_ps(y, y));
+    return _mm256_mul_ps(y, _mm256_sub_ps(set1(1.5f), h));
+#else
+    return div(set1(1.0f), sqrt(a));
+#endif
+  }
+
   static inline const __m256i mask_table[8] = {
       _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, 0),        // 0
       _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, -1),       // 1
@@ -67,6 +87,77 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm256_set1_ps(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理8条记录 2/3/4分量为shuffle/blend序列
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 8);
+      // 每个128位通道内取偶/奇位置 再按64位交换中间两段
+      const type a = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+      const type b = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+      storeu(rows[0] + i, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(a), 0xD8)));
+      storeu(rows[1] + i, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(b), 0xD8)));
+    } else if constexpr (N == 3) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 8), v2 = loadu(aos + 16);
+      // 同一分量在三个向量中的位置互不重叠 两次blend拼合后一次置换
+      const type x = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x92), v2, 0x24);
+      const type y = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x24), v2, 0x49);
+      const type z = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x49), v2, 0x92);
+      storeu(rows[0] + i, _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5)));
+      storeu(rows[1] + i, _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6)));
+      storeu(rows[2] + i, _mm256_permutevar8x32_ps(z, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7)));
+    } else if constexpr (N == 4) {
+      const type r01 = loadu(aos), r23 = loadu(aos + 8), r45 = loadu(aos + 16), r67 = loadu(aos + 24);
+      // 低通道放记录0~3 高通道放记录4~7 之后各通道内4x4转置
+      type u0 = _mm256_permute2f128_ps(r01, r45, 0x20), u1 = _mm256_permute2f128_ps(r01, r45, 0x31);
+      type u2 = _mm256_permute2f128_ps(r23, r67, 0x20), u3 = _mm256_permute2f128_ps(r23, r67, 0x31);
+      transpose4x4(u0, u1, u2, u3);
+      storeu(rows[0] + i, u0);
+      storeu(rows[1] + i, u1);
+      storeu(rows[2] + i, u2);
+      storeu(rows[3] + i, u3);
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(loadu(rows[0] + i)), 0xD8));
+      const type b = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(loadu(rows[1] + i)), 0xD8));
+      storeu(aos, _mm256_unpacklo_ps(a, b));
+      storeu(aos + 8, _mm256_unpackhi_ps(a, b));
+    } else if constexpr (N == 3) {
+      // deinterleave的逆过程: 先置换到目标位置 再按位置blend
+      const type x = _mm256_permutevar8x32_ps(loadu(rows[0] + i), _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+      const type y = _mm256_permutevar8x32_ps(loadu(rows[1] + i), _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+      const type z = _mm256_permutevar8x32_ps(loadu(rows[2] + i), _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+      storeu(aos, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x92), z, 0x24));
+      storeu(aos + 8, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x24), z, 0x49));
+      storeu(aos + 16, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x49), z, 0x92));
+    } else if constexpr (N == 4) {
+      type u0 = loadu(rows[0] + i), u1 = loadu(rows[1] + i), u2 = loadu(rows[2] + i), u3 = loadu(rows[3] + i);
+      transpose4x4(u0, u1, u2, u3);
+      storeu(aos, _mm256_permute2f128_ps(u0, u1, 0x20));
+      storeu(aos + 8, _mm256_permute2f128_ps(u2, u3, 0x20));
+      storeu(aos + 16, _mm256_permute2f128_ps(u0, u1, 0x31));
+      storeu(aos + 24, _mm256_permute2f128_ps(u2, u3, 0x31));
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
+
+  // 两个128位通道内各自做4x4转置
+  static inline void transpose4x4(type& r0, type& r1, type& r2, type& r3) {
+    const type t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpacklo_ps(r2, r3);
+    const type t2 = _mm256_unpackhi_ps(r0, r1), t3 = _mm256_unpackhi_ps(r2, r3);
+    r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
 };
 
 template <>
@@ -89,6 +180,17 @@ struct simd<double> {
   static inline type mul(const_ref_type a, const_ref_type b) { return _mm256_mul_pd(a, b); }
   static inline type div(const_ref_type a, const_ref_type b) { return _mm256_div_pd(a, b); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) {
+#ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+  static inline type sqrt(const_ref_type a) { return _mm256_sqrt_pd(a); }
+  static inline type rsqrt(const_ref_type a) { return div(set1(1.0), sqrt(a)); }
+
   static inline const __m256i mask_table[4] = {
       _mm256_set_epi64x(0, 0, 0, 0),    // 0
       _mm256_set_epi64x(0, 0, 0, -1),   // 1
@@ -126,6 +228,70 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm256_set1_pd(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理4条记录
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 4);
+      storeu(rows[0] + i, _mm256_permute4x64_pd(_mm256_unpacklo_pd(v0, v1), 0xD8));
+      storeu(rows[1] + i, _mm256_permute4x64_pd(_mm256_unpackhi_pd(v0, v1), 0xD8));
+    } else if constexpr (N == 3) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 4), v2 = loadu(aos + 8);
+      // 先按128位重组为 [x0 y0|x2 y2] [z0 x1|z2 x3] [y1 z1|y3 z3] 再通道内shuffle
+      const type t0 = _mm256_permute2f128_pd(v0, v1, 0x30);
+      const type t1 = _mm256_permute2f128_pd(v0, v2, 0x21);
+      const type t2 = _mm256_permute2f128_pd(v1, v2, 0x30);
+      storeu(rows[0] + i, _mm256_shuffle_pd(t0, t1, 0b1010));
+      storeu(rows[1] + i, _mm256_shuffle_pd(t0, t2, 0b0101));
+      storeu(rows[2] + i, _mm256_shuffle_pd(t1, t2, 0b1010));
+    } else if constexpr (N == 4) {
+      type r0 = loadu(aos), r1 = loadu(aos + 4), r2 = loadu(aos + 8), r3 = loadu(aos + 12);
+      transpose4x4(r0, r1, r2, r3);
+      storeu(rows[0] + i, r0);
+      storeu(rows[1] + i, r1);
+      storeu(rows[2] + i, r2);
+      storeu(rows[3] + i, r3);
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = _mm256_permute4x64_pd(loadu(rows[0] + i), 0xD8);
+      const type b = _mm256_permute4x64_pd(loadu(rows[1] + i), 0xD8);
+      storeu(aos, _mm256_unpacklo_pd(a, b));
+      storeu(aos + 4, _mm256_unpackhi_pd(a, b));
+    } else if constexpr (N == 3) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i);
+      const type t0 = _mm256_shuffle_pd(x, y, 0b0000);
+      const type t1 = _mm256_shuffle_pd(z, x, 0b1010);
+      const type t2 = _mm256_shuffle_pd(y, z, 0b1111);
+      storeu(aos, _mm256_permute2f128_pd(t0, t1, 0x20));
+      storeu(aos + 4, _mm256_permute2f128_pd(t2, t0, 0x30));
+      storeu(aos + 8, _mm256_permute2f128_pd(t1, t2, 0x31));
+    } else if constexpr (N == 4) {
+      type r0 = loadu(rows[0] + i), r1 = loadu(rows[1] + i), r2 = loadu(rows[2] + i), r3 = loadu(rows[3] + i);
+      transpose4x4(r0, r1, r2, r3);
+      storeu(aos, r0);
+      storeu(aos + 4, r1);
+      storeu(aos + 8, r2);
+      storeu(aos + 12, r3);
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
+
+  static inline void transpose4x4(type& r0, type& r1, type& r2, type& r3) {
+    const type t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+    const type t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+    r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
 };
 
 }  // namespace md
@@ -29,6 +29,20 @@ struct simd<float> {
   static inline type mul(const_ref_type a, const_ref_type b) { return _mm512_mul_ps(a, b); }
   static inline type div(const_ref_type a, const_ref_type b) { return _mm512_div_ps(a, b); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return _mm512_fmadd_ps(a, b, c); }
+  static inline type sqrt(const_ref_type a) { return _mm512_sqrt_ps(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值加一次牛顿迭代 否则为精确结果
+  static inline type rsqrt(const_ref_type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    const type y = _mm512_rsqrt14_ps(a);
+    const type h = _mm512_mul_ps(_mm512_mul_ps(set1(0.5f), a), _mm512_mul_ps(y, y));
+    return _mm512_mul_ps(y, _mm512_sub_ps(set1(1.5f), h));
+#else
+    return div(set1(1.0f), sqrt(a));
+#endif
+  }
+
   static inline __mmask16 mask(const size_t& remaining) { return (1u << remaining) - 1; }
 
   static inline type mask_load(const float* p, const size_t& remaining) {
@@ -45,6 +59,75 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm512_set1_ps(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理16条记录 2/3/4分量为置换序列 其余逐元素处理
+  // 3分量: 每行的元素分布在三个向量中 双源置换只能取两个 先从前两个向量取 再用带掩码的单源置换补上第三个
+  // 两步共用一个索引 单源置换只看低4位 即第三个向量内的位置
+  // 4分量: 两两合并为两个分量各8条记录 再合并为整行
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 16);
+      storeu(rows[0] + i, _mm512_permutex2var_ps(v0, _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), v1));
+      storeu(rows[1] + i, _mm512_permutex2var_ps(v0, _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31), v1));
+    } else if constexpr (N == 3) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 16), v2 = loadu(aos + 32);
+      const __m512i ix = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 1, 4, 7, 10, 13);
+      const __m512i iy = _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 2, 5, 8, 11, 14);
+      const __m512i iz = _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 3, 6, 9, 12, 15);
+      storeu(rows[0] + i, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(v0, ix, v1), 0xF800, ix, v2));
+      storeu(rows[1] + i, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(v0, iy, v1), 0xF800, iy, v2));
+      storeu(rows[2] + i, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(v0, iz, v1), 0xFC00, iz, v2));
+    } else if constexpr (N == 4) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 16), v2 = loadu(aos + 32), v3 = loadu(aos + 48);
+      // 低半为8条记录的分量0(2) 高半为分量1(3)
+      const __m512i i01 = _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 1, 5, 9, 13, 17, 21, 25, 29);
+      const __m512i i23 = _mm512_setr_epi32(2, 6, 10, 14, 18, 22, 26, 30, 3, 7, 11, 15, 19, 23, 27, 31);
+      const type a01 = _mm512_permutex2var_ps(v0, i01, v1), a23 = _mm512_permutex2var_ps(v0, i23, v1);
+      const type b01 = _mm512_permutex2var_ps(v2, i01, v3), b23 = _mm512_permutex2var_ps(v2, i23, v3);
+      const __m512i lo = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23);
+      const __m512i hi = _mm512_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31);
+      storeu(rows[0] + i, _mm512_permutex2var_ps(a01, lo, b01));
+      storeu(rows[1] + i, _mm512_permutex2var_ps(a01, hi, b01));
+      storeu(rows[2] + i, _mm512_permutex2var_ps(a23, lo, b23));
+      storeu(rows[3] + i, _mm512_permutex2var_ps(a23, hi, b23));
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = loadu(rows[0] + i), b = loadu(rows[1] + i);
+      storeu(aos, _mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23), b));
+      storeu(aos + 16, _mm512_permutex2var_ps(a, _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31), b));
+    } else if constexpr (N == 3) {
+      // deinterleave的逆过程: 分量0/1由双源置换放到目标位置 分量2的位置再由带掩码的置换填入
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i);
+      const __m512i i0 = _mm512_setr_epi32(0, 16, 0, 1, 17, 1, 2, 18, 2, 3, 19, 3, 4, 20, 4, 5);
+      const __m512i i1 = _mm512_setr_epi32(21, 5, 6, 22, 6, 7, 23, 7, 8, 24, 8, 9, 25, 9, 10, 26);
+      const __m512i i2 = _mm512_setr_epi32(10, 11, 27, 11, 12, 28, 12, 13, 29, 13, 14, 30, 14, 15, 31, 15);
+      storeu(aos, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(x, i0, y), 0x4924, i0, z));
+      storeu(aos + 16, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(x, i1, y), 0x2492, i1, z));
+      storeu(aos + 32, _mm512_mask_permutexvar_ps(_mm512_permutex2var_ps(x, i2, y), 0x9249, i2, z));
+    } else if constexpr (N == 4) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i), w = loadu(rows[3] + i);
+      // 低半为记录0~7(8~15)的分量0(2) 高半为分量1(3)
+      const __m512i lo = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23);
+      const __m512i hi = _mm512_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31);
+      const type a01 = _mm512_permutex2var_ps(x, lo, y), a23 = _mm512_permutex2var_ps(z, lo, w);
+      const type b01 = _mm512_permutex2var_ps(x, hi, y), b23 = _mm512_permutex2var_ps(z, hi, w);
+      const __m512i r0 = _mm512_setr_epi32(0, 8, 16, 24, 1, 9, 17, 25, 2, 10, 18, 26, 3, 11, 19, 27);
+      const __m512i r4 = _mm512_setr_epi32(4, 12, 20, 28, 5, 13, 21, 29, 6, 14, 22, 30, 7, 15, 23, 31);
+      storeu(aos, _mm512_permutex2var_ps(a01, r0, a23));
+      storeu(aos + 16, _mm512_permutex2var_ps(a01, r4, a23));
+      storeu(aos + 32, _mm512_permutex2var_ps(b01, r0, b23));
+      storeu(aos + 48, _mm512_permutex2var_ps(b01, r4, b23));
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 
 template <>
@@ -67,6 +150,21 @@ struct simd<double> {
   static inline type mul(const_ref_type a, const_ref_type b) { return _mm512_mul_pd(a, b); }
   static inline type div(const_ref_type a, const_ref_type b) { return _mm512_div_pd(a, b); }
 
+  // a * b + c
+  static inline type fma(const_ref_type a, const_ref_type b, const_ref_type c) { return _mm512_fmadd_pd(a, b, c); }
+  static inline type sqrt(const_ref_type a) { return _mm512_sqrt_pd(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值(14位)加两次牛顿迭代 否则为精确结果
+  static inline type rsqrt(const_ref_type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    type y = _mm512_rsqrt14_pd(a);
+    const type half_a = _mm512_mul_pd(set1(0.5), a);
+    y = _mm512_mul_pd(y, _mm512_sub_pd(set1(1.5), _mm512_mul_pd(half_a, _mm512_mul_pd(y, y))));
+    return _mm512_mul_pd(y, _mm512_sub_pd(set1(1.5), _mm512_mul_pd(half_a, _mm512_mul_pd(y, y))));
+#else
+    return div(set1(1.0), sqrt(a));
+#endif
+  }
+
   static inline __mmask8 mask(const size_t& remaining) { return (1u << remaining) - 1; }
 
   static inline type mask_load(const double* p, const size_t& remaining) {
@@ -83,6 +181,69 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm512_set1_pd(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理8条记录 2/3/4分量为置换序列 其余逐元素处理 做法同float
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 8);
+      storeu(rows[0] + i, _mm512_permutex2var_pd(v0, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), v1));
+      storeu(rows[1] + i, _mm512_permutex2var_pd(v0, _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), v1));
+    } else if constexpr (N == 3) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 8), v2 = loadu(aos + 16);
+      const __m512i ix = _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 2, 5);
+      const __m512i iy = _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 3, 6);
+      const __m512i iz = _mm512_setr_epi64(2, 5, 8, 11, 14, 1, 4, 7);
+      storeu(rows[0] + i, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(v0, ix, v1), 0xC0, ix, v2));
+      storeu(rows[1] + i, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(v0, iy, v1), 0xE0, iy, v2));
+      storeu(rows[2] + i, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(v0, iz, v1), 0xE0, iz, v2));
+    } else if constexpr (N == 4) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 8), v2 = loadu(aos + 16), v3 = loadu(aos + 24);
+      const __m512i i01 = _mm512_setr_epi64(0, 4, 8, 12, 1, 5, 9, 13);
+      const __m512i i23 = _mm512_setr_epi64(2, 6, 10, 14, 3, 7, 11, 15);
+      const type a01 = _mm512_permutex2var_pd(v0, i01, v1), a23 = _mm512_permutex2var_pd(v0, i23, v1);
+      const type b01 = _mm512_permutex2var_pd(v2, i01, v3), b23 = _mm512_permutex2var_pd(v2, i23, v3);
+      const __m512i lo = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+      const __m512i hi = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+      storeu(rows[0] + i, _mm512_permutex2var_pd(a01, lo, b01));
+      storeu(rows[1] + i, _mm512_permutex2var_pd(a01, hi, b01));
+      storeu(rows[2] + i, _mm512_permutex2var_pd(a23, lo, b23));
+      storeu(rows[3] + i, _mm512_permutex2var_pd(a23, hi, b23));
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = loadu(rows[0] + i), b = loadu(rows[1] + i);
+      storeu(aos, _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), b));
+      storeu(aos + 8, _mm512_permutex2var_pd(a, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), b));
+    } else if constexpr (N == 3) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i);
+      const __m512i i0 = _mm512_setr_epi64(0, 8, 0, 1, 9, 1, 2, 10);
+      const __m512i i1 = _mm512_setr_epi64(2, 3, 11, 3, 4, 12, 4, 5);
+      const __m512i i2 = _mm512_setr_epi64(13, 5, 6, 14, 6, 7, 15, 7);
+      storeu(aos, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(x, i0, y), 0x24, i0, z));
+      storeu(aos + 8, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(x, i1, y), 0x49, i1, z));
+      storeu(aos + 16, _mm512_mask_permutexvar_pd(_mm512_permutex2var_pd(x, i2, y), 0x92, i2, z));
+    } else if constexpr (N == 4) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i), w = loadu(rows[3] + i);
+      const __m512i lo = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+      const __m512i hi = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+      const type a01 = _mm512_permutex2var_pd(x, lo, y), a23 = _mm512_permutex2var_pd(z, lo, w);
+      const type b01 = _mm512_permutex2var_pd(x, hi, y), b23 = _mm512_permutex2var_pd(z, hi, w);
+      const __m512i r0 = _mm512_setr_epi64(0, 4, 8, 12, 1, 5, 9, 13);
+      const __m512i r2 = _mm512_setr_epi64(2, 6, 10, 14, 3, 7, 11, 15);
+      storeu(aos, _mm512_permutex2var_pd(a01, r0, a23));
+      storeu(aos + 8, _mm512_permutex2var_pd(a01, r2, a23));
+      storeu(aos + 16, _mm512_permutex2var_pd(b01, r0, b23));
+      storeu(aos + 24, _mm512_permutex2var_pd(b01, r2, b23));
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 
 }  // namespace md
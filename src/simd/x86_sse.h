@@ -29,6 +29,20 @@ struct simd<float> {
   static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
   static inline type div(type a, type b) { return _mm_div_ps(a, b); }
 
+  // a * b + c
+  static inline type fma(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  static inline type sqrt(type a) { return _mm_sqrt_ps(a); }
+  // 1 / sqrt(a) 定义MDVECTOR_FAST_RSQRT时使用硬件估计值加一次牛顿迭代 否则为精确结果
+  static inline type rsqrt(type a) {
+#ifdef MDVECTOR_FAST_RSQRT
+    const type y = _mm_rsqrt_ps(a);
+    const type h = _mm_mul_ps(_mm_mul_ps(set1(0.5f), a), _mm_mul_ps(y, y));
+    return _mm_mul_ps(y, _mm_sub_ps(set1(1.5f), h));
+#else
+    return div(set1(1.0f), sqrt(a));
+#endif
+  }
+
   // 对齐掩码操作（SSE没有原生支持，使用临时缓冲区）
   static inline type mask_load(const float* p, const size_t& remaining) {
     alignas(16) float tmp[4] = {0, 0, 0, 0};
@@ -62,6 +76,43 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm_set1_ps(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理4条记录 3分量逐元素处理
+  template <size_t N>
+  static inline void deinterleave(const float* aos, float* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 4);
+      storeu(rows[0] + i, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+      storeu(rows[1] + i, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+    } else if constexpr (N == 4) {
+      type r0 = loadu(aos), r1 = loadu(aos + 4), r2 = loadu(aos + 8), r3 = loadu(aos + 12);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      storeu(rows[0] + i, r0);
+      storeu(rows[1] + i, r1);
+      storeu(rows[2] + i, r2);
+      storeu(rows[3] + i, r3);
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const float* const* rows, float* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = loadu(rows[0] + i), b = loadu(rows[1] + i);
+      storeu(aos, _mm_unpacklo_ps(a, b));
+      storeu(aos + 4, _mm_unpackhi_ps(a, b));
+    } else if constexpr (N == 4) {
+      type r0 = loadu(rows[0] + i), r1 = loadu(rows[1] + i), r2 = loadu(rows[2] + i), r3 = loadu(rows[3] + i);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      storeu(aos, r0);
+      storeu(aos + 4, r1);
+      storeu(aos + 8, r2);
+      storeu(aos + 12, r3);
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 
 template <>
@@ -84,6 +135,11 @@ struct simd<double> {
   static inline type mul(type a, type b) { return _mm_mul_pd(a, b); }
   static inline type div(type a, type b) { return _mm_div_pd(a, b); }
 
+  // a * b + c
+  static inline type fma(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  static inline type sqrt(type a) { return _mm_sqrt_pd(a); }
+  static inline type rsqrt(type a) { return div(set1(1.0), sqrt(a)); }
+
   // 对齐掩码操作
   static inline type mask_load(const double* p, const size_t& remaining) {
     alignas(16) double tmp[2] = {0, 0};
@@ -117,6 +173,53 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm_set1_pd(val); }
+
+  // 交错存放的N分量记录与N行互转 每次处理2条记录
+  template <size_t N>
+  static inline void deinterleave(const double* aos, double* const* rows, size_t i) {
+    if constexpr (N == 2) {
+      const type v0 = loadu(aos), v1 = loadu(aos + 2);
+      storeu(rows[0] + i, _mm_unpacklo_pd(v0, v1));
+      storeu(rows[1] + i, _mm_unpackhi_pd(v0, v1));
+    } else if constexpr (N == 3) {
+      // [x0 y0] [z0 x1] [y1 z1]
+      const type v0 = loadu(aos), v1 = loadu(aos + 2), v2 = loadu(aos + 4);
+      storeu(rows[0] + i, _mm_shuffle_pd(v0, v1, 0b10));
+      storeu(rows[1] + i, _mm_shuffle_pd(v0, v2, 0b01));
+      storeu(rows[2] + i, _mm_shuffle_pd(v1, v2, 0b10));
+    } else if constexpr (N == 4) {
+      // [x0 y0] [z0 w0] [x1 y1] [z1 w1]
+      const type v0 = loadu(aos), v1 = loadu(aos + 2), v2 = loadu(aos + 4), v3 = loadu(aos + 6);
+      storeu(rows[0] + i, _mm_unpacklo_pd(v0, v2));
+      storeu(rows[1] + i, _mm_unpackhi_pd(v0, v2));
+      storeu(rows[2] + i, _mm_unpacklo_pd(v1, v3));
+      storeu(rows[3] + i, _mm_unpackhi_pd(v1, v3));
+    } else {
+      deinterleave_scalar<N, pack_size>(aos, rows, i);
+    }
+  }
+
+  template <size_t N>
+  static inline void interleave(const double* const* rows, double* aos, size_t i) {
+    if constexpr (N == 2) {
+      const type a = loadu(rows[0] + i), b = loadu(rows[1] + i);
+      storeu(aos, _mm_unpacklo_pd(a, b));
+      storeu(aos + 2, _mm_unpackhi_pd(a, b));
+    } else if constexpr (N == 3) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i);
+      storeu(aos, _mm_unpacklo_pd(x, y));
+      storeu(aos + 2, _mm_shuffle_pd(z, x, 0b10));
+      storeu(aos + 4, _mm_unpackhi_pd(y, z));
+    } else if constexpr (N == 4) {
+      const type x = loadu(rows[0] + i), y = loadu(rows[1] + i), z = loadu(rows[2] + i), w = loadu(rows[3] + i);
+      storeu(aos, _mm_unpacklo_pd(x, y));
+      storeu(aos + 2, _mm_unpacklo_pd(z, w));
+      storeu(aos + 4, _mm_unpackhi_pd(x, y));
+      storeu(aos + 6, _mm_unpackhi_pd(z, w));
+    } else {
+      interleave_scalar<N, pack_size>(rows, aos, i);
+    }
+  }
 };
 
 }  // namespace md
@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 接管对齐的外部内存 不拷贝 析构时调用deleter
+  int released = 0;
+  auto deleter = [&released](double *p) {
+    ++released;
+    std::free(p);
+  };
+  const size_t n = 1000;
+  double *raw = static_cast<double *>(std::aligned_alloc(64, 4 * n * sizeof(double)));
+  for (size_t i = 0; i < 4 * n; ++i) raw[i] = double(i);
+  {
+    vector_2d<double> v(md::adopt, raw, {4, n}, deleter);
+    std::cout << "adopt: same data = " << (v.begin() == raw) << " adopted = " << v.is_adopted()
+              << " (expected 1 1)\n";
+
+    v = v * 2.0 + 1.0;
+    std::cout << "expression in place: v(1,0) = " << v(1, 0) << " raw[n] = " << raw[n] << " (expected 2001 2001)\n";
+
+    vector_2d<double> moved = std::move(v);
+    std::cout << "move: released = " << released << " moved.begin() == raw = " << (moved.begin() == raw)
+              << " (expected 0 1)\n";
+
+    vector_2d<double> copy = moved;
+    std::cout << "copy: adopted = " << copy.is_adopted() << " (expected 0)\n";
+
+    // 超出外部内存的容量时改为自行分配 原内存随即交还deleter
+    moved.reset_shape({8, n});
+    std::cout << "grow: released = " << released << " adopted = " << moved.is_adopted() << " v(1,0) = " << moved(1, 0)
+              << " (expected 1 0 2001)\n";
+  }
+  std::cout << "destroy: released = " << released << " (expected 1)\n";
+
+  {
+    vector_1d<double> v(md::adopt, static_cast<double *>(std::aligned_alloc(64, 64 * sizeof(double))), {64}, deleter);
+  }
+  std::cout << "destroy adopted: released = " << released << " (expected 2)\n";
+
+  // 未对齐的内存不能接管 所有权仍归调用方
+  std::vector<double> host(n + 1, 1.0);
+  double *misaligned = md::is_simd_aligned(host.data()) ? host.data() + 1 : host.data();
+  try {
+    vector_1d<double> bad(md::adopt, misaligned, {n}, deleter);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "misaligned: " << e.what() << " released = " << released << " (expected exception, 2)\n";
+  }
+
+  // 非浮点类型不要求对齐
+  int int_released = 0;
+  {
+    mdvector<int, 1> iv(md::adopt, new int[3]{1, 2, 3}, {3}, [&int_released](int *p) {
+      ++int_released;
+      delete[] p;
+    });
+    std::cout << "int adopt: iv(2) = " << iv(2) << " (expected 3)\n";
+  }
+  std::cout << "int destroy: released = " << int_released << " (expected 1)\n";
+
+  // span直接包装未对齐的外部内存参与计算
+  md::span<double, 2> s(misaligned, {10, n / 10});
+  vector_2d<double> w({10, n / 10});
+  w.set_value(3.0);
+  s = s * 2.0 + w;
+  s += w;
+  s *= 0.5;
+  std::cout << "span misaligned: s(9,99) = " << s(9, 99) << " (expected 4)\n";
+
+  md::span<double, 1> a(raw = static_cast<double *>(std::aligned_alloc(64, n * sizeof(double))), {n});
+  a.set_value(1.0);
+  a -= 0.5;
+  vector_1d<double> sum = a + a;
+  std::cout << "span aligned: sum(999) = " << sum(999) << " (expected 1)\n";
+  std::free(raw);
+  return 0;
+}
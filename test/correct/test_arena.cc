@@ -0,0 +1,103 @@
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  vector_2d<double> a({3, 5});
+  vector_2d<double> res({3, 5});
+  a.set_value(0.25);
+
+  md::scratch_arena arena(1 << 20);
+
+  for (int step = 0; step < 3; step++) {
+    md::scratch_scope scope(arena);
+
+    // 时间步内的临时变量全部来自arena
+    vector_2d<double> temp = a.sqrt() + 1.0;
+    vector_2d<double> temp2({3, 5});
+    temp2 = temp * a.cos();
+    std::cout << "step " << step << ": arena used = " << arena.used() << " (expected > 0)"
+              << ", temp owned by arena = " << (md::scratch_arena::owner(&temp(0, 0)) == &arena) << " (expected 1)\n";
+
+    // 结果写入作用域外的mdvector
+    res = temp2 + 0.0;
+  }
+
+  std::cout << "after scope: arena used = " << arena.used() << " (expected 0)\n";
+  std::cout << "res(2,4) = " << res(2, 4) << " (expected " << (std::sqrt(0.25) + 1.0) * std::cos(0.25) << ")\n";
+
+  // 暂停arena 创建需要长期保留的结果
+  vector_2d<double> keep;
+  {
+    md::scratch_scope scope(arena);
+    md::scratch_scope pause(nullptr);
+    keep.reset_shape({3, 5});
+    keep = a + 1.0;
+  }
+  std::cout << "paused: keep owned by arena = " << (md::scratch_arena::owner(&keep(0, 0)) != nullptr)
+            << " (expected 0), keep(0,0) = " << keep(0, 0) << " (expected 1.25)\n";
+
+  // 容量不足时回退到堆分配
+  {
+    md::scratch_arena small(64);
+    md::scratch_scope scope(small);
+    vector_1d<double> big({1000});
+    big.set_value(2.0);
+    std::cout << "fallback: big owned by arena = " << (md::scratch_arena::owner(&big(0)) != nullptr)
+              << " (expected 0), big(999) = " << big(999) << " (expected 2)\n";
+  }
+
+  // 激活线程上先进后出的释放立即回收
+  {
+    md::scratch_scope scope(arena);
+    const size_t before = arena.used();
+    { vector_1d<double> t({100}); }
+    std::cout << "lifo: used after release = " << (arena.used() == before) << " (expected 1), heap owner = "
+              << (md::scratch_arena::owner(keep.begin()) != nullptr) << " (expected 0)\n";
+  }
+
+  // 作用域内重新分配的mdvector逃出作用域 其内存不会被之后的分配复用
+  vector_1d<double> escaped;
+  {
+    md::scratch_scope scope(arena);
+    escaped.reset_shape({100});
+    escaped.set_value(3.0);
+  }
+  {
+    md::scratch_scope scope(arena);
+    vector_1d<double> other({100});
+    other.set_value(-1.0);
+    std::cout << "escaped: escaped(99) = " << escaped(99) << " (expected 3), overlap = " << (&other(0) == &escaped(0))
+              << " (expected 0)\n";
+  }
+
+  // 在其他线程释放arena上的内存
+  {
+    md::scratch_scope scope(arena);
+    auto moved = std::make_unique<vector_1d<double>>(shape_1d{100});
+    std::thread([v = std::move(moved)]() mutable { v.reset(); }).join();
+  }
+  std::cout << "other thread: arena owner of escaped = " << (md::scratch_arena::owner(&escaped(0)) == &arena)
+            << " (expected 1)\n";
+
+  // arena析构后才释放的内存
+  vector_1d<double> outlive;
+  {
+    md::scratch_arena local(1 << 16);
+    md::scratch_scope scope(local);
+    outlive.reset_shape({100});
+    outlive.set_value(5.0);
+  }
+  std::cout << "outlive: outlive(99) = " << outlive(99) << " (expected 5), owner = "
+            << (md::scratch_arena::owner(&outlive(0)) != nullptr) << " (expected 0)\n";
+  outlive = vector_1d<double>();
+
+  escaped = vector_1d<double>();
+  std::cout << "released: arena used = " << arena.used() << " (expected 0)\n";
+
+  return 0;
+}
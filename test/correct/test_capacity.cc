@@ -0,0 +1,49 @@
+#include <string>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  vector_2d<double> a({10, 100});
+  a.set_value(1.5);
+
+  // 预留容量 保留原有元素
+  a.reserve(2000);
+  const double *p = &a(0, 0);
+  std::cout << "reserve: capacity = " << a.capacity() << " (expected 2000), a(9,99) = " << a(9, 99)
+            << " (expected 1.5)\n";
+
+  // 在容量内交替改变形状 不重新分配
+  bool same = true;
+  for (int step = 0; step < 10; step++) {
+    a.reset_shape({step % 2 ? size_t(20) : size_t(15), 100}, md::discard);
+    same = same && (&a(0, 0) == p);
+  }
+  std::cout << "discard: same buffer = " << same << " (expected 1), size = " << a.size() << " (expected 2000)\n";
+
+  // 超出容量时重新分配
+  a.reset_shape({30, 100}, md::discard);
+  std::cout << "discard grow: capacity = " << a.capacity() << " (expected 3000)\n";
+
+  // 默认reset_shape保留原有元素
+  a.set_value(2.0);
+  a.reset_shape({5, 100});
+  std::cout << "reset_shape: a(4,99) = " << a(4, 99) << " (expected 2), capacity = " << a.capacity()
+            << " (expected 3000)\n";
+
+  // 释放多余容量
+  a.shrink_to_fit();
+  std::cout << "shrink_to_fit: capacity = " << a.capacity() << " (expected 500), a(4,99) = " << a(4, 99)
+            << " (expected 2)\n";
+
+  // 缩小到内联存储
+  a.reset_shape({1, 4});
+  a.shrink_to_fit();
+  std::cout << "shrink inline: a(0,3) = " << a(0, 3) << " (expected 2), data inside object = "
+            << (reinterpret_cast<const char *>(&a(0, 0)) >= reinterpret_cast<const char *>(&a) &&
+                reinterpret_cast<const char *>(&a(0, 0)) < reinterpret_cast<const char *>(&a) + sizeof(a))
+            << " (expected 1)\n";
+
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <string>
+
+#include "mdarray.h"
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 静态/动态混合维度
+  md::extents<md::dyn, 4, 3> ext({5, 4, 3});
+  std::cout << "extents: rank_dynamic = " << md::extents<md::dyn, 4, 3>::rank_dynamic << " (expected 1), extent(0) = "
+            << ext.extent(0) << " (expected 5), size = " << ext.size() << " (expected 60)\n";
+
+  using mapping = md::layout_mapping<md::extents<md::dyn, 4, 3>>;
+  using mapping2 = md::layout_mapping<md::extents<3, md::dyn>>;
+  std::cout << "static strides: " << mapping::static_stride<0>() << " " << mapping::static_stride<1>() << " "
+            << mapping::static_stride<2>() << " (expected 12 3 1), dynamic stride = "
+            << (mapping2::static_stride<0>() == md::dyn) << " (expected 1)\n";
+
+  // mdvector以混合维度访问
+  vector_3d<double> v({5, 4, 3});
+  for (size_t i = 0; i < v.size(); i++) v.begin()[i] = double(i);
+  auto sv = v.view<md::dyn, md::dyn, 3>();
+  std::cout << "mdvector view: sv(4,3,2) = " << sv(4, 3, 2) << " (expected " << v(4, 3, 2) << "), sv(1,2,0) = "
+            << sv(1, 2, 0) << " (expected " << v(1, 2, 0) << ")\n";
+
+  // 列优先
+  mdvector<double, 2, md::layout_left> l({3, 4});
+  for (size_t i = 0; i < l.size(); i++) l.begin()[i] = double(i);
+  auto sl = l.view<3, md::dyn>();
+  std::cout << "layout_left view: sl(2,3) = " << sl(2, 3) << " (expected " << l(2, 3) << ")\n";
+
+  // 静态维度与实际形状不一致
+  try {
+    (void)v.view<md::dyn, 5, 3>();
+    std::cout << "mismatch: no exception (expected exception)\n";
+  } catch (const std::invalid_argument &) {
+    std::cout << "mismatch: exception (expected exception)\n";
+  }
+
+  // mdarray全部为静态维度
+  array_3d<double, 2, 3, 4> a(0.0);
+  a(1, 2, 3) = 7.0;
+  a(0, 1, 2) = 5.0;
+  std::cout << "mdarray: a(1,2,3) = " << a(1, 2, 3) << " (expected 7), view(0,1,2) = " << a.view()(0, 1, 2)
+            << " (expected 5), data[23] = " << a.begin()[23] << " (expected 7)\n";
+
+  try {
+    a.at(2, 0, 0);
+    std::cout << "mdarray at: no exception (expected exception)\n";
+  } catch (const std::out_of_range &) {
+    std::cout << "mdarray at: exception (expected exception)\n";
+  }
+
+  return 0;
+}
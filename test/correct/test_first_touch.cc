@@ -0,0 +1,63 @@
+#include <string>
+
+#include "mdvector.h"
+#include "parallel/parallel_eval.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 不初始化构造 随后整体覆盖
+  vector_2d<double> a({300, 500}, md::uninitialized);
+  a.set_value(2.0);
+  std::cout << "uninitialized: size = " << a.size() << " (expected 150000), a(299,499) = " << a(299, 499)
+            << " (expected 2)\n";
+
+  // 并行首次触碰 结果为全零
+  vector_2d<double> b({300, 500}, md::first_touch);
+  double sum = 0.0;
+  for (auto v : b) sum += v;
+  std::cout << "first_touch: sum = " << sum << " (expected 0)\n";
+
+  // 低于并行阈值时在当前线程置零
+  vector_1d<double> small({1000}, md::first_touch);
+  sum = 0.0;
+  for (auto v : small) sum += v;
+  std::cout << "small first_touch: sum = " << sum << " (expected 0)\n";
+
+  // 与首次触碰相同划分的并行计算
+  vector_2d<double> c({300, 500}, md::first_touch);
+  b.set_value(0.5);
+  md::parallel_assign(c, a * b + 1.0);
+  bool ok = true;
+  for (auto v : c) ok = ok && v == 2.0;
+  std::cout << "parallel_assign: all equal = " << ok << " (expected 1)\n";
+
+  // 长度不是页与包长整数倍
+  vector_1d<double> d({100003}, md::first_touch);
+  vector_1d<double> e({100003});
+  e.set_value(3.0);
+  md::parallel_assign(d, e * 2.0);
+  ok = true;
+  for (auto v : d) ok = ok && v == 6.0;
+  std::cout << "odd length: all equal = " << ok << " (expected 1)\n";
+
+  // 划分覆盖全部元素且互不重叠
+  auto &pool = md::thread_pool::instance();
+  size_t covered = 0;
+  size_t prev_end = 0;
+  bool contiguous = true;
+  for (size_t part = 0; part < pool.size(); ++part) {
+    auto range = md::page_partition(d.begin(), d.size(), pool.size(), part);
+    contiguous = contiguous && range.first == prev_end;
+    covered += range.second - range.first;
+    prev_end = range.second;
+  }
+  std::cout << "partition: covered = " << covered << " (expected 100003), contiguous = " << contiguous
+            << " (expected 1)\n";
+
+  // 表达式构造只写一遍
+  vector_2d<double> f = a + b;
+  std::cout << "expr ctor: f(0,0) = " << f(0, 0) << " (expected 2.5)\n";
+
+  return 0;
+}
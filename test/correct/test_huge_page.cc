@@ -0,0 +1,54 @@
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 大于1MB的数组使用透明大页
+  md::huge_pages().mode = md::huge_page_mode::transparent;
+  md::huge_pages().threshold_bytes = size_t(1) << 20;
+
+  vector_2d<double> a({512, 1024});
+  vector_2d<double> b({512, 1024});
+  vector_2d<double> small({4, 4});
+  a.set_value(1.0);
+  b.set_value(2.0);
+
+  const auto page_offset = [](const double *p) { return reinterpret_cast<uintptr_t>(p) % (size_t(2) << 20); };
+  std::cout << "large: 2MB aligned = " << (page_offset(&a(0, 0)) == 0) << " (expected 1)\n";
+  std::cout << "small: simd aligned = " << (reinterpret_cast<uintptr_t>(&small(0, 0)) % md::simd<double>::alignment == 0)
+            << " (expected 1)\n";
+
+  vector_2d<double> c = a + b * 2.0;
+  std::cout << "c(511,1023) = " << c(511, 1023) << " (expected 5)\n";
+
+  // 显式大页 未预留时回退到透明大页
+  md::huge_pages().mode = md::huge_page_mode::hugetlb;
+  vector_2d<double> d = c - a;
+  std::cout << "hugetlb: 2MB aligned = " << (page_offset(&d(0, 0)) == 0) << " (expected 1), d(0,0) = " << d(0, 0)
+            << " (expected 4)\n";
+
+  // 其他线程修改配置的同时分配
+  std::atomic<bool> done{false};
+  std::thread toggler([&] {
+    for (int i = 0; !done; ++i) {
+      md::huge_pages().mode = i % 2 ? md::huge_page_mode::transparent : md::huge_page_mode::none;
+      md::huge_pages().threshold_bytes = size_t(1) << (19 + i % 3);
+    }
+  });
+  bool ok = true;
+  for (int i = 0; i < 20; ++i) {
+    vector_2d<double> e({512, 1024}, md::first_touch);
+    e = a + 1.0;
+    ok = ok && e(511, 1023) == 2.0;
+  }
+  done = true;
+  toggler.join();
+  std::cout << "concurrent config: ok = " << ok << " (expected 1)\n";
+
+  md::huge_pages().mode = md::huge_page_mode::none;
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <string>
+
+#include "mdarray.h"
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 按内存顺序遍历 下标与operator()一致
+  vector_3d<double> v({3, 4, 5});
+  for (size_t i = 0; i < v.size(); i++) v.begin()[i] = double(i);
+  bool ok = true;
+  size_t count = 0;
+  md::for_each_index(v, [&](const std::array<size_t, 3> &idx, double &x) {
+    ok = ok && x == v(idx[0], idx[1], idx[2]) && x == double(count);
+    count++;
+  });
+  std::cout << "mdvector: match = " << ok << " (expected 1), count = " << count << " (expected 60)\n";
+
+  // 列优先
+  mdvector<double, 2, md::layout_left> l({3, 4});
+  for (size_t i = 0; i < l.size(); i++) l.begin()[i] = double(i);
+  ok = true;
+  count = 0;
+  md::for_each_index(l, [&](const std::array<size_t, 2> &idx, double &x) {
+    ok = ok && x == l(idx[0], idx[1]) && x == double(count);
+    count++;
+  });
+  std::cout << "layout_left: match = " << ok << " (expected 1), count = " << count << " (expected 12)\n";
+
+  // 坐标相关的赋值
+  array_2d<double, 3, 5> a(0.0);
+  md::for_each_index(a, [](const std::array<size_t, 2> &idx, double &x) { x = double(idx[0] * 10 + idx[1]); });
+  std::cout << "mdarray: a(2,4) = " << a(2, 4) << " (expected 24)\n";
+
+  // 子视图
+  auto s = v.span(1, md::all(), md::all());
+  double sum = 0.0;
+  md::for_each_index(s, [&](const std::array<size_t, 2> &idx, double &x) { sum += x; });
+  std::cout << "span: sum = " << sum << " (expected " << (20 + 39) * 20 / 2 << ")\n";
+
+  // 坐标迭代器
+  count = 0;
+  size_t last_offset = 0;
+  for (auto it = md::indices(v).begin(); it != md::index_sentinel{}; ++it) {
+    last_offset = it.offset();
+    count++;
+  }
+  std::cout << "iterator: count = " << count << " (expected 60), last offset = " << last_offset << " (expected 59)\n";
+
+  // 整行交给simd回调
+  size_t rows = 0;
+  md::for_each_row(v, [&](const std::array<size_t, 3> &idx, double *row, size_t n) {
+    constexpr size_t pack = md::simd<double>::pack_size;
+    size_t j = 0;
+    for (; j + pack <= n; j += pack) {
+      auto x = md::simd<double>::loadu(row + j);
+      md::simd<double>::storeu(row + j, md::simd<double>::mul(x, md::simd<double>::set1(2.0)));
+    }
+    for (; j < n; j++) row[j] *= 2.0;
+    rows++;
+  });
+  std::cout << "rows: count = " << rows << " (expected 12), v(2,3,4) = " << v(2, 3, 4) << " (expected 118)\n";
+
+  return 0;
+}
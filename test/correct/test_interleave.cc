@@ -0,0 +1,63 @@
+#include <iostream>
+#include <vector>
+
+#include "mdvector.h"
+#include "multi_dimension/interleave.h"
+
+struct pos3d {
+  double x, y, z;
+};
+
+template <size_t N, class T>
+bool round_trip(size_t n, bool use_parallel) {
+  std::vector<T> aos(N * n);
+  for (size_t i = 0; i < aos.size(); ++i) aos[i] = T(i);
+  mdvector<T, 2> soa({N, n});
+  if (use_parallel) {
+    md::deinterleave<N>(aos.data(), soa, md::parallel);
+  } else {
+    md::deinterleave<N>(aos.data(), soa);
+  }
+  bool ok = true;
+  for (size_t c = 0; c < N; ++c)
+    for (size_t i = 0; i < n; ++i) ok = ok && soa(c, i) == T(i * N + c);
+
+  std::vector<T> back(N * n, T(-1));
+  if (use_parallel) {
+    md::interleave<N>(soa, back.data(), md::parallel);
+  } else {
+    md::interleave<N>(soa, back.data());
+  }
+  return ok && back == aos;
+}
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 结构体数组直接转为{3, n}
+  std::vector<pos3d> pos(37);
+  for (size_t i = 0; i < pos.size(); ++i) pos[i] = {i * 1.0, i * 2.0, i * 3.0};
+  mdvector<double, 2> soa({3, pos.size()});
+  md::deinterleave<3>(&pos[0].x, soa);
+  std::cout << "pos3d: y[36] = " << soa(1, 36) << " (expected 72), z[5] = " << soa(2, 5) << " (expected 15)\n";
+
+  // 2/3/4分量 长度不是包长整数倍
+  std::cout << "double: N=2 " << round_trip<2, double>(101, false) << ", N=3 " << round_trip<3, double>(101, false)
+            << ", N=4 " << round_trip<4, double>(101, false) << " (expected 1, 1, 1)\n";
+  std::cout << "float: N=2 " << round_trip<2, float>(103, false) << ", N=3 " << round_trip<3, float>(103, false)
+            << ", N=4 " << round_trip<4, float>(103, false) << " (expected 1, 1, 1)\n";
+
+  // 大规模并行
+  std::cout << "parallel: N=3 " << round_trip<3, double>(200003, true) << ", N=4 "
+            << round_trip<4, float>(200003, true) << " (expected 1, 1)\n";
+
+  // 形状不匹配
+  try {
+    mdvector<double, 2> wrong({2, pos.size()});
+    md::deinterleave<3>(&pos[0].x, wrong);
+    std::cout << "shape check: no exception (expected exception)\n";
+  } catch (const std::invalid_argument &e) {
+    std::cout << "shape check: " << e.what() << " (expected exception)\n";
+  }
+  return 0;
+}
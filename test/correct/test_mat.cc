@@ -0,0 +1,128 @@
+#include <cmath>
+#include <iostream>
+
+#include "mdvector.h"
+#include "multi_dimension/mat.h"
+
+// 批量矩阵a * inverse(a)与单位矩阵的最大偏差
+template <size_t D>
+double inverse_error(size_t n) {
+  vector_3d<double> a({D, D, n});
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t r = 0; r < D; ++r) {
+      for (size_t c = 0; c < D; ++c) a(r, c, i) = (r == c ? 4.0 : 0.0) + std::sin(double(1 + r * D + c + i));
+    }
+  }
+  auto prod = md::mat::matmul(a, md::mat::inverse(a));
+  double err = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t r = 0; r < D; ++r) {
+      for (size_t c = 0; c < D; ++c) err = std::max(err, std::abs(prod(r, c, i) - (r == c ? 1.0 : 0.0)));
+    }
+  }
+  return err;
+}
+
+// 特征向量的最大误差: max(|v^T v - I|, |a v - v diag(w)|)
+// 包含一般矩阵 二重根 三重根与对角矩阵
+template <size_t D>
+double eigh_error(size_t n) {
+  vector_3d<double> a({D, D, n});
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t r = 0; r < D; ++r) {
+      for (size_t c = r; c < D; ++c) a(r, c, i) = a(c, r, i) = std::sin(double(1 + r * D + c + 7 * i));
+    }
+  }
+  // [[2 1 0] [1 2 0] [0 0 3]]的特征值为1 3 3  2I的特征值全部相等
+  for (size_t r = 0; r < D; ++r) {
+    for (size_t c = 0; c < D; ++c) a(r, c, 0) = a(r, c, 1) = a(r, c, 2) = 0.0;
+    a(r, r, 0) = 2.0, a(r, r, 1) = 2.0, a(r, r, 2) = 1.0 + r;
+  }
+  a(0, 1, 0) = a(1, 0, 0) = 1.0;
+  if (D == 3) a(2, 2, 0) = 3.0;
+
+  auto [w, v] = md::mat::eigh(a);
+  double err = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < D; ++j) {
+      for (size_t k = 0; k < D; ++k) {
+        double dot = 0.0;
+        for (size_t r = 0; r < D; ++r) dot += v(r, j, i) * v(r, k, i);
+        err = std::max(err, std::abs(dot - (j == k ? 1.0 : 0.0)));
+      }
+      for (size_t r = 0; r < D; ++r) {
+        double av = 0.0;
+        for (size_t c = 0; c < D; ++c) av += a(r, c, i) * v(c, j, i);
+        err = std::max(err, std::abs(av - w(j, i) * v(r, j, i)));
+      }
+    }
+  }
+  return err;
+}
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 11个矩阵 长度不是包长整数倍
+  const size_t n = 11;
+  vector_3d<double> a({3, 3, n});
+  vector_2d<double> x({3, n});
+  for (size_t i = 0; i < n; ++i) {
+    // [[2 1 0] [1 2 0] [0 0 5 + i]]
+    a(0, 0, i) = 2.0, a(0, 1, i) = 1.0, a(0, 2, i) = 0.0;
+    a(1, 0, i) = 1.0, a(1, 1, i) = 2.0, a(1, 2, i) = 0.0;
+    a(2, 0, i) = 0.0, a(2, 1, i) = 0.0, a(2, 2, i) = 5.0 + i;
+    x(0, i) = 1.0, x(1, i) = 2.0, x(2, i) = 3.0;
+  }
+
+  auto d = md::mat::det(a);
+  std::cout << "det: d(10) = " << d(10) << " (expected 45)\n";
+
+  auto y = md::mat::matvec(a, x);
+  std::cout << "matvec: y(:,10) = " << y(0, 10) << " " << y(1, 10) << " " << y(2, 10) << " (expected 4 5 45)\n";
+
+  vector_3d<double> u({3, 3, n});
+  for (size_t i = 0; i < n; ++i) u(0, 2, i) = 7.0;
+  auto t = md::mat::transpose(u);
+  std::cout << "transpose: t(2,0,3) = " << t(2, 0, 3) << " t(0,2,3) = " << t(0, 2, 3) << " (expected 7 0)\n";
+
+  std::cout << "2x2 inverse: max |a a^-1 - I| < 1e-12 = " << (inverse_error<2>(n) < 1e-12) << " (expected 1)\n";
+  std::cout << "3x3 inverse: max |a a^-1 - I| < 1e-12 = " << (inverse_error<3>(n) < 1e-12) << " (expected 1)\n";
+  std::cout << "4x4 inverse: max |a a^-1 - I| < 1e-12 = " << (inverse_error<4>(n) < 1e-12) << " (expected 1)\n";
+
+  // 4x4行列式: diag(1, 2, 3, 4)加一个上三角元素
+  vector_3d<double> b({4, 4, n});
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t r = 0; r < 4; ++r) b(r, r, i) = 1.0 + r;
+    b(0, 3, i) = 9.0;
+  }
+  std::cout << "4x4 det: d(0) = " << md::mat::det(b)(0) << " (expected 24)\n";
+
+  auto e = md::mat::eigvalsh(a);
+  std::cout << "3x3 eigvalsh: e(:,10) = " << e(0, 10) << " " << e(1, 10) << " " << e(2, 10)
+            << " (expected 1 3 15)\n";
+
+  vector_3d<double> s({2, 2, n});
+  for (size_t i = 0; i < n; ++i) s(0, 0, i) = 2.0, s(0, 1, i) = 1.0, s(1, 0, i) = 1.0, s(1, 1, i) = 2.0;
+  auto e2 = md::mat::eigvalsh(s);
+  std::cout << "2x2 eigvalsh: e(:,4) = " << e2(0, 4) << " " << e2(1, 4) << " (expected 1 3)\n";
+
+  // 数量矩阵 三个特征值相等
+  vector_3d<double> id({3, 3, n});
+  for (size_t i = 0; i < n; ++i) id(0, 0, i) = id(1, 1, i) = id(2, 2, i) = 2.0;
+  auto ei = md::mat::eigvalsh(id);
+  std::cout << "eigvalsh of 2I: e(:,0) = " << ei(0, 0) << " " << ei(1, 0) << " " << ei(2, 0) << " (expected 2 2 2)\n";
+
+  std::cout << "2x2 eigh: error < 1e-12 = " << (eigh_error<2>(n) < 1e-12) << " (expected 1)\n";
+  std::cout << "3x3 eigh: error < 1e-12 = " << (eigh_error<3>(n) < 1e-12) << " (expected 1)\n";
+  auto [ew, ev] = md::mat::eigh(a);
+  std::cout << "3x3 eigh: w(:,10) = " << ew(0, 10) << " " << ew(1, 10) << " " << ew(2, 10)
+            << ", |v(2,2,10)| = " << std::abs(ev(2, 2, 10)) << " (expected 1 3 15, 1)\n";
+
+  try {
+    md::mat::eigvalsh(b);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "size check: " << e.what() << " (expected exception)\n";
+  }
+  return 0;
+}
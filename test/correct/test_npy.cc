@@ -0,0 +1,106 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "io/npy.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // mdvector 行优先
+  vector_2d<double> a({3, 4});
+  double val = 0.0;
+  for (auto &it : a) {
+    it = val++;
+  }
+  md::save_npy("test_npy_a.npy", a);
+
+  vector_2d<double> a_load = md::load_npy<double, 2>("test_npy_a.npy");
+  std::cout << "load: a(2,3) = " << a_load(2, 3) << " (expected 11)\n";
+  std::cout << "load: shape = " << a_load.extent(0) << "*" << a_load.extent(1) << " (expected 3*4)\n";
+
+  // 列优先 对应fortran_order
+  mdvector<float, 2, md::layout_left> b({2, 3});
+  float fval = 0.0f;
+  for (auto &it : b) {
+    it = fval++;
+  }
+  md::save_npy("test_npy_b.npy", b);
+  auto b_load = md::load_npy<float, 2, md::layout_left>("test_npy_b.npy");
+  std::cout << "layout_left: b(1,2) = " << b_load(1, 2) << " (expected 5)\n";
+
+  try {
+    md::load_npy<float, 2>("test_npy_b.npy");
+  } catch (const std::exception &e) {
+    std::cout << "捕获异常: " << e.what() << "\n";
+  }
+
+  // mdarray
+  array_2d<double, 2, 2> c;
+  c(1, 1) = 4.0;
+  md::save_npy("test_npy_c.npy", c);
+  array_2d<double, 2, 2> c_load(0.0);
+  md::load_npy("test_npy_c.npy", c_load);
+  std::cout << "mdarray: c(1,1) = " << c_load(1, 1) << " c(0,0) = " << c_load(0, 0) << " (expected 4 1)\n";
+
+  // 内存映射 零拷贝
+  auto mapped = md::map_npy<double, 2>("test_npy_a.npy");
+  std::cout << "mmap: zero_copy = " << mapped.zero_copy() << " (expected 1)\n";
+  vector_2d<double> a_mapped = mapped.span() + 1.0;
+  std::cout << "mmap: a(2,3) + 1 = " << a_mapped(2, 3) << " (expected 12)\n";
+
+  // 截断的文件 映射时检查数据区长度
+  {
+    std::ifstream in("test_npy_a.npy", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out("test_npy_trunc.npy", std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+  }
+  try {
+    auto truncated = md::map_npy<double, 2>("test_npy_trunc.npy");
+    std::cout << "mmap: truncated file mapped (expected exception)\n";
+  } catch (const std::exception &e) {
+    std::cout << "mmap: truncated: " << e.what() << " (expected npy: unexpected end of file)\n";
+  }
+
+  // 数据区起点未对齐(16字节对齐的旧式文件头)时读入内存 小数组保存在对象内部 移动后仍须可读
+  {
+    std::string dict = "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 2), }";
+    dict.resize(69, ' ');
+    dict += '\n';
+    const char prefix[10] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0, char(dict.size()), 0};
+    const double values[4] = {1.0, 2.0, 3.0, 4.0};
+    std::ofstream out("test_npy_unaligned.npy", std::ios::binary);
+    out.write(prefix, 10);
+    out.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+    out.write(reinterpret_cast<const char *>(values), sizeof(values));
+  }
+  auto small = md::map_npy<double, 2>("test_npy_unaligned.npy");
+  md::mapped_npy<double, 2> moved(std::move(small));
+  {
+    md::mapped_npy<double, 2> tmp(std::move(moved));
+    moved = std::move(tmp);
+  }
+  const char *self = reinterpret_cast<const char *>(&moved);
+  const char *ptr = reinterpret_cast<const char *>(moved.data());
+  std::cout << "mmap: unaligned zero_copy = " << moved.zero_copy() << " data in object = "
+            << (ptr >= self && ptr < self + sizeof(moved)) << " (expected 0 1)\n";
+  std::cout << "mmap: moved (1,1) = " << moved.span()(1, 1) << " (expected 4)\n";
+
+  // npz 不压缩归档
+  {
+    md::npz_writer npz("test_npy.npz");
+    npz.add("a", a);
+    npz.add("c", c);
+  }
+  md::npz_reader npz("test_npy.npz");
+  std::cout << "npz: names =";
+  for (const auto &name : npz.names()) {
+    std::cout << " " << name;
+  }
+  std::cout << " (expected a c)\n";
+  vector_2d<double> a_npz = npz.load<double, 2>("a");
+  std::cout << "npz: a(1,2) = " << a_npz(1, 2) << " (expected 6)\n";
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <string>
+
+#include "io/out_of_core.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  const size_t rows = 1000;
+  const size_t cols = 1003;
+
+  // 准备磁盘上的输入
+  {
+    vector_2d<double> a({rows, cols});
+    vector_2d<double> b({rows, cols});
+    double val = 0.0;
+    for (auto &it : a) {
+      it = val++;
+    }
+    b.set_value(0.5);
+    md::save_npy("test_ooc_a.npy", a);
+    md::save_npy("test_ooc_b.npy", b);
+  }
+
+  auto a = md::map_npy<double, 2>("test_ooc_a.npy");
+  auto b = md::map_npy<double, 2>("test_ooc_b.npy");
+  auto res = md::create_npy<double, 2>("test_ooc_res.npy", {rows, cols});
+
+  // 小块以覆盖多次预取与尾部掩码
+  md::out_of_core_options options;
+  options.chunk_bytes = 64 * 1024;
+  md::eval_out_of_core(res, a.span() * 2.0 + b.span(), options);
+
+  std::cout << "res(0,0) = " << res.data()[0] << " (expected 0.5)\n";
+  std::cout << "res(last) = " << res.data()[rows * cols - 1] << " (expected " << (rows * cols - 1) * 2.0 + 0.5
+            << ")\n";
+
+  // 回读文件验证写回
+  vector_2d<double> check = md::load_npy<double, 2>("test_ooc_res.npy");
+  double max_err = 0.0;
+  for (size_t i = 0; i < rows * cols; ++i) {
+    max_err = std::max(max_err, std::abs(check.begin()[i] - (i * 2.0 + 0.5)));
+  }
+  std::cout << "reload max error = " << max_err << " (expected 0)\n";
+
+  return 0;
+}
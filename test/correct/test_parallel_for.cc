@@ -0,0 +1,62 @@
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+#include "mdvector.h"
+#include "parallel/parallel_for.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 按维度遍历 每个下标恰好访问一次
+  vector_3d<double> a({40, 30, 50});
+  md::parallel_for(a.extents(), [&](size_t i, size_t j, size_t k) { a(i, j, k) += i * 10000 + j * 100 + k; });
+  bool ok = true;
+  for (size_t i = 0; i < 40; ++i)
+    for (size_t j = 0; j < 30; ++j)
+      for (size_t k = 0; k < 50; ++k) ok = ok && a(i, j, k) == i * 10000 + j * 100 + k;
+  std::cout << "extents: all visited once = " << ok << " (expected 1)\n";
+
+  // 最外层维度小于线程数时仍然全部覆盖
+  std::vector<std::atomic<int>> hits(2 * 100000);
+  md::parallel_for(std::array<size_t, 2>{2, 100000}, [&](size_t i, size_t j) { hits[i * 100000 + j]++; });
+  ok = true;
+  for (auto &h : hits) ok = ok && h == 1;
+  std::cout << "short outer dimension: all visited once = " << ok << " (expected 1)\n";
+
+  // 容器下标 列优先
+  mdvector<double, 2, md::layout_left> b({301, 257});
+  md::parallel_for(b, [&](size_t i, size_t j) { b(i, j) = double(i) - double(j); });
+  ok = true;
+  for (size_t i = 0; i < 301; ++i)
+    for (size_t j = 0; j < 257; ++j) ok = ok && b(i, j) == double(i) - double(j);
+  std::cout << "layout_left: all equal = " << ok << " (expected 1)\n";
+
+  // 逐行遍历 分界对齐缓存行 行可能被拆成两段
+  vector_2d<float> c({123, 777});
+  std::atomic<size_t> total{0};
+  std::atomic<bool> aligned{true};
+  md::parallel_for_rows(c, [&](const std::array<size_t, 2> &idx, float *row, size_t n) {
+    for (size_t k = 0; k < n; ++k) row[k] = float(idx[0] * 1000 + idx[1] + k);
+    total += n;
+    const bool row_start = idx[1] == 0;
+    const bool line_start = reinterpret_cast<uintptr_t>(row) % md::cache_line_bytes == 0;
+    if (!row_start && !line_start) aligned = false;
+  });
+  ok = true;
+  for (size_t i = 0; i < 123; ++i)
+    for (size_t j = 0; j < 777; ++j) ok = ok && c(i, j) == float(i * 1000 + j);
+  std::cout << "rows: total = " << total << " (expected 95571), all equal = " << ok
+            << " (expected 1), split rows aligned = " << aligned << " (expected 1)\n";
+
+  // 小规模时串行执行
+  vector_2d<double> d({3, 4});
+  md::parallel_for(d, [&](size_t i, size_t j) { d(i, j) = i * 4 + j; });
+  std::cout << "small: d(2,3) = " << d(2, 3) << " (expected 11)\n";
+
+  // 堆上分配按缓存行对齐
+  vector_1d<double> e({1000});
+  std::cout << "cache line aligned: " << (reinterpret_cast<uintptr_t>(e.begin()) % md::cache_line_bytes == 0)
+            << " (expected 1)\n";
+  return 0;
+}
@@ -0,0 +1,70 @@
+#include <cmath>
+#include <iostream>
+
+#include "mdvector.h"
+#include "multi_dimension/quat.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 11个四元数 长度不是包长整数倍
+  const size_t n = 11;
+  const double h = std::sqrt(0.5);
+  vector_2d<double> p({4, n});
+  vector_2d<double> q({4, n});
+  vector_2d<double> v({3, n});
+  for (size_t i = 0; i < n; ++i) {
+    // p: 1 + 2i + 3j + 4k q: 5 + 6i + 7j + 8k
+    p(0, i) = 1.0, p(1, i) = 2.0, p(2, i) = 3.0, p(3, i) = 4.0;
+    q(0, i) = 5.0, q(1, i) = 6.0, q(2, i) = 7.0, q(3, i) = 8.0 + i;
+    v(0, i) = 1.0, v(1, i) = 0.0, v(2, i) = double(i);
+  }
+
+  // (1 + 2i + 3j + 4k)(5 + 6i + 7j + 8k) = -60 + 12i + 30j + 24k
+  auto pq = md::quat::multiply(p, q);
+  std::cout << "multiply: pq(:,0) = " << pq(0, 0) << " " << pq(1, 0) << " " << pq(2, 0) << " " << pq(3, 0)
+            << " (expected -60 12 30 24)\n";
+
+  auto c = md::quat::conjugate(p);
+  std::cout << "conjugate: c(:,10) = " << c(0, 10) << " " << c(1, 10) << " " << c(2, 10) << " " << c(3, 10)
+            << " (expected 1 -2 -3 -4)\n";
+
+  auto len = md::quat::norm(p);
+  std::cout << "norm: len(5) = " << len(5) << " (expected " << std::sqrt(30.0) << ")\n";
+
+  // q * conj(q) = |q|^2
+  auto qq = md::quat::multiply(q, md::quat::conjugate(q));
+  std::cout << "q * conj(q): qq(:,10) = " << qq(0, 10) << " " << qq(1, 10) << " " << qq(2, 10) << " " << qq(3, 10)
+            << " (expected 434 0 0 0)\n";
+
+  md::quat::normalize(q, q);
+  auto qlen = md::quat::norm(q);
+  double max_err = 0.0;
+  for (size_t i = 0; i < n; ++i) max_err = std::max(max_err, std::abs(qlen(i) - 1.0));
+  std::cout << "normalize in place: max |len - 1| < 1e-12 = " << (max_err < 1e-12) << " (expected 1)\n";
+
+  // 绕z轴转90度: (1, 0, z) -> (0, 1, z)
+  vector_2d<double> rz({4, n});
+  for (size_t i = 0; i < n; ++i) rz(0, i) = h, rz(1, i) = 0.0, rz(2, i) = 0.0, rz(3, i) = h;
+  auto r = md::quat::rotate(rz, v);
+  std::cout << "rotate: r(:,10) = " << (std::abs(r(0, 10)) < 1e-12 ? 0.0 : r(0, 10)) << " " << r(1, 10) << " " << r(2, 10)
+            << " (expected 0 1 10)\n";
+
+  // 旋转结果与q * (0, v) * conj(q)一致
+  vector_2d<double> pv({4, n});
+  for (size_t i = 0; i < n; ++i) pv(0, i) = 0.0, pv(1, i) = v(0, i), pv(2, i) = v(1, i), pv(3, i) = v(2, i);
+  auto sandwich = md::quat::multiply(md::quat::multiply(q, pv), md::quat::conjugate(q));
+  auto rq = md::quat::rotate(q, v);
+  max_err = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < 3; ++k) max_err = std::max(max_err, std::abs(rq(k, i) - sandwich(k + 1, i)));
+  }
+  std::cout << "rotate == q v q*: max err < 1e-12 = " << (max_err < 1e-12) << " (expected 1)\n";
+
+  try {
+    md::quat::rotate(v, v);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "shape check: " << e.what() << " (expected exception)\n";
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include <string>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  const size_t n = 1000;
+  vector_1d<double> a({n});
+  vector_1d<double> b({n});
+  vector_1d<double> c({n});
+  a.set_value(4.0);
+  b.set_value(3.0);
+  c.set_value(0.0);
+
+  // 右值mdvector的内存被结果接管
+  vector_1d<double> s = a.sqrt();
+  const double *p = &s(0);
+  vector_1d<double> r = std::move(s) * b + 1.0;
+  std::cout << "steal: same buffer = " << (p == &r(0)) << " (expected 1), r(999) = " << r(999) << " (expected 7)\n";
+
+  // 多级临时变量只分配两次(sqrt与cos)
+  md::scratch_arena arena(1 << 20);
+  {
+    md::scratch_scope scope(arena);
+    vector_1d<double> res = sqrt(a) * b + cos(c);
+    std::cout << "chain: allocations = " << arena.used() / (n * sizeof(double)) << " (expected 2), res(0) = " << res(0)
+              << " (expected 7)\n";
+  }
+
+  // 右值调用数学函数时原地计算
+  {
+    md::scratch_scope scope(arena);
+    vector_1d<double> res = cos(sqrt(a) * 0.0);
+    std::cout << "in place math: allocations = " << arena.used() / (n * sizeof(double)) << " (expected 1), res(5) = "
+              << res(5) << " (expected 1)\n";
+  }
+
+  // 左值表达式不会被接管 可以重复计算
+  auto e = sqrt(a) * b;
+  vector_1d<double> r1 = e;
+  vector_1d<double> r2 = e;
+  std::cout << "lvalue expr: r1(0) = " << r1(0) << " (expected 6), r2(0) = " << r2(0) << " (expected 6)\n";
+
+  // 形状不同时不接管
+  vector_2d<double> m({10, 100});
+  m.set_value(2.0);
+  vector_2d<double> mm = m * 2.0 + m;
+  std::cout << "2d: mm(9,99) = " << mm(9, 99) << " (expected 6)\n";
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <string>
+
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 1x4 double补齐后32字节 存放在对象内部
+  vector_2d<double> a({1, 4});
+  vector_2d<double> b({1, 4});
+  a.set_value(1.5);
+  b.set_value(2.0);
+  vector_2d<double> c = a * b + a;
+  std::cout << "inline: c data inside object = "
+            << (reinterpret_cast<const char *>(&c(0, 0)) >= reinterpret_cast<const char *>(&c) &&
+                reinterpret_cast<const char *>(&c(0, 0)) < reinterpret_cast<const char *>(&c) + sizeof(c))
+            << " (expected 1), c(0,3) = " << c(0, 3) << " (expected 4.5)\n";
+  std::cout << "inline: aligned = " << (reinterpret_cast<uintptr_t>(&c(0, 0)) % md::simd<double>::alignment == 0)
+            << " (expected 1)\n";
+
+  // 移动与拷贝后数据跟随对象
+  vector_2d<double> d(std::move(c));
+  vector_2d<double> e(d);
+  e(0, 0) = -1.0;
+  std::cout << "move: d(0,3) = " << d(0, 3) << " (expected 4.5), d(0,0) = " << d(0, 0)
+            << " (expected 4.5), e(0,0) = " << e(0, 0) << " (expected -1)\n";
+
+  // 大数组在堆上 移动只交换指针
+  vector_2d<double> big({1, 50});
+  big.set_value(3.0);
+  const double *p = &big(0, 0);
+  vector_2d<double> moved(std::move(big));
+  std::cout << "heap: pointer kept after move = " << (p == &moved(0, 0)) << " (expected 1), moved(0,49) = "
+            << moved(0, 49) << " (expected 3)\n";
+
+  // 内联与堆之间赋值和改变形状
+  vector_2d<double> f({1, 10});
+  f.set_value(1.0);
+  f = d;
+  std::cout << "assign: f(0,2) = " << f(0, 2) << " (expected 4.5), f.size() = " << f.size() << " (expected 4)\n";
+  f.reset_shape({2, 10});
+  f(1, 9) = 7.0;
+  std::cout << "grow: f(0,3) = " << f(0, 3) << " (expected 4.5), f(1,9) = " << f(1, 9) << " (expected 7)"
+            << ", f(1,0) = " << f(1, 0) << " (expected 0)\n";
+
+  std::swap(f, d);
+  std::cout << "swap: f.size() = " << f.size() << " (expected 4), d(1,9) = " << d(1, 9) << " (expected 7)\n";
+
+  return 0;
+}
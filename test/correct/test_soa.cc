@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <iostream>
+
+#include "mdvector.h"
+#include "multi_dimension/soa.h"
+
+struct x {};
+struct y {};
+struct z {};
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 具名字段 一次分配
+  md::soa<double, 1, x, y, z> pos({10});
+  pos.get<x>().set_value(1.0);
+  pos.get<y>().set_value(2.0);
+  pos.get<z>() = pos.get<x>() + pos.get<y>() * 3.0;
+  std::cout << "named: z[9] = " << pos.get<z>()(9) << " (expected 7), fields = " << pos.field_count
+            << " (expected 3)\n";
+
+  // 字段起点对齐到缓存行
+  std::cout << "stride = " << pos.stride() << " (expected 16), z offset = " << pos.field_data(2) - pos.data()
+            << " (expected 32)\n";
+
+  // 小数组也在堆上 起点对齐到缓存行
+  md::soa<float, 1, x> small({2});
+  const auto *obj = reinterpret_cast<const char *>(&small);
+  const auto *p = reinterpret_cast<const char *>(small.data());
+  std::cout << "small: heap = " << (p < obj || p >= obj + sizeof(small))
+            << ", aligned = " << (reinterpret_cast<uintptr_t>(p) % 64 == 0) << " (expected 1, 1)\n";
+
+  // const对象只读访问
+  const auto &cpos = pos;
+  std::cout << "const get: y[3] = " << cpos.get<y>()(3) << ", field<2>[3] = " << cpos.get<2>()(3)
+            << " (expected 2, 7)\n";
+
+  // 字段作为表达式操作数 结果写入mdvector
+  vector_1d<double> len = pos.get<z>() - pos.get<x>();
+  std::cout << "expression: len[0] = " << len(0) << " (expected 6)\n";
+
+  // 按序号访问 2维字段
+  md::soa_n<float, 2, 2> uv({3, 5});
+  uv.get<0>().set_value(0.5f);
+  uv.get<1>() = uv.get<0>() * 4.0f;
+  std::cout << "indexed: uv1(2,4) = " << uv.get<1>()(2, 4) << " (expected 2)\n";
+
+  // 一起改变形状 保留原有元素 新增元素置零
+  pos.reset_shape({100});
+  std::cout << "reset_shape: size = " << pos.size() << " (expected 100), z[9] = " << pos.get<z>()(9)
+            << " (expected 7), z[50] = " << pos.get<z>()(50) << " (expected 0), y[0] = " << pos.get<y>()(0)
+            << " (expected 2)\n";
+
+  // discard不保留元素 容量足够时不重新分配
+  const double *before = pos.data();
+  pos.reset_shape({20}, md::discard);
+  std::cout << "discard: same buffer = " << (pos.data() == before) << " (expected 1), size = " << pos.size()
+            << " (expected 20)\n";
+  return 0;
+}
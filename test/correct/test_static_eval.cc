@@ -0,0 +1,39 @@
+#include <string>
+
+#include "mdarray.h"
+#include "mdvector.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 3x3 补齐后完全展开
+  array_2d<double, 3, 3> a(2.0);
+  array_2d<double, 3, 3> b(0.5);
+  array_2d<double, 3, 3> c(0.0);
+  c = a * b + a / b - 1.0;
+  std::cout << "3x3: c(2,2) = " << c(2, 2) << " (expected 4), padded expr = "
+            << md::is_padded_expr_v<decltype(a * b + 1.0), array_2d<double, 3, 3>::padded_size> << " (expected 1)\n";
+
+  c += a;
+  c *= b;
+  std::cout << "compound: c(0,0) = " << c(0, 0) << " (expected 3)\n";
+
+  c -= a * b;
+  c /= b;
+  std::cout << "compound expr: c(1,2) = " << c(1, 2) << " (expected 4)\n";
+
+  // 超过展开上限时使用循环
+  array_2d<float, 20, 21> d(1.5f);
+  array_2d<float, 20, 21> e(2.0f);
+  d = d * e + 3.0f;
+  std::cout << "20x21: d(19,20) = " << d(19, 20) << " (expected 6), d(0,0) = " << d(0, 0) << " (expected 6)\n";
+
+  // 与mdvector混合时退回运行期路径
+  vector_2d<double> v({3, 3});
+  v.set_value(4.0);
+  c = a + v;
+  std::cout << "mixed: c(1,1) = " << c(1, 1) << " (expected 6), padded expr = "
+            << md::is_padded_expr_v<decltype(a + v), array_2d<double, 3, 3>::padded_size> << " (expected 0)\n";
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+
+#include "mdarray.h"
+#include "mdvector.h"
+#include "multi_dimension/layout_tiled.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  using tiled_4x4 = md::layout_tiled<4, 4>;
+
+  // 10x7按4x4分块: 块(0,0)为前16个元素 块(0,1)为4x3 边缘块(2,*)只有2行
+  mdvector<double, 2, tiled_4x4> a({10, 7});
+  std::cout << "offsets: (0,3) = " << &a(0, 3) - a.begin() << " (expected 3), (1,0) = " << &a(1, 0) - a.begin()
+            << " (expected 4), (0,4) = " << &a(0, 4) - a.begin() << " (expected 16), (1,5) = " << &a(1, 5) - a.begin()
+            << " (expected 20), (8,0) = " << &a(8, 0) - a.begin() << " (expected 56), (9,6) = " << &a(9, 6) - a.begin()
+            << " (expected 69)\n";
+
+  // 行优先 <-> 分块 往返转换
+  vector_2d<double> r({10, 7});
+  for (size_t i = 0; i < 10; ++i)
+    for (size_t j = 0; j < 7; ++j) r(i, j) = i * 10 + j;
+  auto t = md::to_tiled<tiled_4x4>(r);
+  bool ok = true;
+  for (size_t i = 0; i < 10; ++i)
+    for (size_t j = 0; j < 7; ++j) ok = ok && t(i, j) == r(i, j);
+  std::cout << "to_tiled: all equal = " << ok << " (expected 1)\n";
+
+  // 逐元素表达式在分块数据上连续计算
+  mdvector<double, 2, tiled_4x4> s = t * 2.0 + t;
+  auto back = md::to_row_major(s);
+  ok = true;
+  for (size_t i = 0; i < 10; ++i)
+    for (size_t j = 0; j < 7; ++j) ok = ok && back(i, j) == 3.0 * (i * 10 + j);
+  std::cout << "expression + to_row_major: all equal = " << ok << " (expected 1)\n";
+
+  // 3维 2x3x4分块
+  using tiled_3d = md::layout_tiled<2, 3, 4>;
+  vector_3d<float> r3({5, 4, 9});
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      for (size_t k = 0; k < 9; ++k) r3(i, j, k) = float(i * 100 + j * 10 + k);
+  auto t3 = md::to_tiled<tiled_3d>(r3);
+  ok = true;
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      for (size_t k = 0; k < 9; ++k) ok = ok && t3(i, j, k) == r3(i, j, k);
+  std::cout << "3d tiled: all equal = " << ok << " (expected 1), (0,0,5) offset = " << &t3(0, 0, 5) - t3.begin()
+            << " (expected 25)\n";
+
+  // 静态分块布局 偏移可在编译期计算
+  mdarray_base<double, tiled_4x4, void, 6, 6> m(0.0);
+  m(5, 5) = 1.0;
+  std::cout << "mdarray tiled: (5,5) offset = " << &m(5, 5) - m.begin() << " (expected 35), at(5,5) = " << m.at(5, 5)
+            << " (expected 1)\n";
+  return 0;
+}
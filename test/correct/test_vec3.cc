@@ -0,0 +1,57 @@
+#include <cmath>
+#include <iostream>
+
+#include "mdvector.h"
+#include "multi_dimension/vec3.h"
+
+int main(int args, char *argv[]) {
+  std::cout << "\nVerification:" << std::endl;
+
+  // 11个向量 长度不是包长整数倍
+  const size_t n = 11;
+  vector_2d<double> a({3, n});
+  vector_2d<double> b({3, n});
+  for (size_t i = 0; i < n; ++i) {
+    a(0, i) = 1.0 + i;
+    a(1, i) = 2.0;
+    a(2, i) = 3.0;
+    b(0, i) = 0.0;
+    b(1, i) = 1.0;
+    b(2, i) = double(i);
+  }
+
+  auto d = md::vec3::dot(a, b);
+  std::cout << "dot: d(10) = " << d(10) << " (expected 32)\n";
+
+  // (11,2,3) x (0,1,10) = (2*10-3*1, 3*0-11*10, 11*1-2*0)
+  auto c = md::vec3::cross(a, b);
+  std::cout << "cross: c(:,10) = " << c(0, 10) << " " << c(1, 10) << " " << c(2, 10) << " (expected 17 -110 11)\n";
+
+  auto len = md::vec3::norm(b);
+  std::cout << "norm: len(3) = " << len(3) << " (expected " << std::sqrt(10.0) << ")\n";
+
+  auto u = md::vec3::normalize(a);
+  auto ulen = md::vec3::norm(u);
+  double max_err = 0.0;
+  for (size_t i = 0; i < n; ++i) max_err = std::max(max_err, std::abs(ulen(i) - 1.0));
+  std::cout << "normalize: max |len - 1| < 1e-12 = " << (max_err < 1e-12) << " (expected 1)\n";
+
+  auto dist = md::vec3::distance(a, b);
+  std::cout << "distance: dist(0) = " << dist(0) << " (expected " << std::sqrt(1.0 + 1.0 + 9.0) << ")\n";
+
+  // 原地归一化 float
+  vector_2d<float> f({3, 20});
+  f.set_value(2.0f);
+  md::vec3::normalize(f, f);
+  std::cout << "normalize in place: f(2,19) = " << f(2, 19) << " (expected " << 1.0f / std::sqrt(3.0f) << ")\n";
+
+  // 形状检查
+  try {
+    vector_2d<double> wrong({2, n});
+    md::vec3::norm(wrong);
+    std::cout << "shape check: no exception (expected exception)\n";
+  } catch (const std::invalid_argument &e) {
+    std::cout << "shape check: " << e.what() << " (expected exception)\n";
+  }
+  return 0;
+}
@@ -32,10 +32,7 @@ void test_valarray() {
   std::valarray<T> data3_(0.0, total_element);
   std::valarray<T> data4_(3.0, total_element);
 
-  TimerRecorder a("valarr");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("valarr", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -53,7 +50,7 @@ void test_valarray() {
     }
 
     val = data1_[0];
-  }
+  });
 }
 
 template <class T>
@@ -79,10 +76,7 @@ void test_norm() {
     }
   }
 
-  TimerRecorder a("** 2d");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("** 2d", [&] {
     if constexpr (do_add) {
       for (size_t i = 0; i < dim1; i++) {
         for (size_t j = 0; j < dim2; j++) {
@@ -116,7 +110,7 @@ void test_norm() {
     }
 
     val = data1_[0][0];
-  }
+  });
 
   delete[] data1_;
   delete[] data2_;
@@ -146,10 +140,7 @@ void test_vector() {
     }
   }
 
-  TimerRecorder a("vector");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("vector", [&] {
     if constexpr (do_add) {
       for (size_t i = 0; i < dim1; i++) {
         for (size_t j = 0; j < dim2; j++) {
@@ -183,7 +174,7 @@ void test_vector() {
     }
 
     val = data1_[0][0];
-  }
+  });
 }
 
 template <class T>
@@ -199,10 +190,7 @@ void test_mdvector_expr() {
   data2_.set_value(2);
   data4_.set_value(3);
 
-  TimerRecorder a("mdvector");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("mdvector", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -219,7 +207,7 @@ void test_mdvector_expr() {
       data3_ = data1_ / data2_;
     }
     val = data1_(0, 0);
-  }
+  });
 }
 
 template <class T, size_t N1, size_t N2>
@@ -234,10 +222,7 @@ void test_mdarray_expr() {
   data2_.set_value(2);
   data4_.set_value(3);
 
-  TimerRecorder a("mdarray");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("mdarray", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -255,7 +240,7 @@ void test_mdarray_expr() {
     }
 
     val = data1_(0, 0);
-  }
+  });
 }
 
 template <class T>
@@ -272,10 +257,7 @@ void test_base_expr() {
     data4_[i] = 3;
   }
 
-  TimerRecorder a("expr");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("expr", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -292,7 +274,7 @@ void test_base_expr() {
       data3_ = data1_ / data2_;
     }
     val = data3_[0];
-  }
+  });
 }
 
 // template <class T>
@@ -311,10 +293,7 @@ void test_base_expr() {
 //     data4_[i] = 4;
 //   }
 
-//   TimerRecorder a("hwy 1d");
-
-//   size_t k = 0;
-//   while (k++ < loop) {
+//   TimerRecorder::Measure<T>("hwy 1d", [&] {
 //     if constexpr (do_add) {
 //       hwy_add(data1_, data2_, data3_, total_element);
 //     }
@@ -330,7 +309,7 @@ void test_base_expr() {
 //     if constexpr (do_div) {
 //       hwy_div<T>(data1_, data2_, data3_, total_element);
 //     }
-//   }
+//   });
 
 //   allocator_.deallocate(data1_);
 //   allocator_.deallocate(data2_);
@@ -353,10 +332,7 @@ void test_simd() {
     data4_[i] = 4;
   }
 
-  TimerRecorder a("simd 1d");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("simd 1d", [&] {
     if constexpr (do_add) {
       md::simd_add<T, md::aligned_policy>(data1_, data2_, data3_, total_element);
     }
@@ -373,7 +349,7 @@ void test_simd() {
       md::simd_div<T, md::aligned_policy>(data1_, data2_, data3_, total_element);
     }
     val = data3_[0];
-  }
+  });
 
   allocator_.deallocate(data1_);
   allocator_.deallocate(data2_);
@@ -399,11 +375,7 @@ void test_eigen_matrixd() {
     }
   }
 
-  TimerRecorder a("eigen");
-
-  double temp;
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<double>("eigen", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -420,7 +392,7 @@ void test_eigen_matrixd() {
       data3_ = data1_.cwiseQuotient(data2_);
     }
     val = data3_(0, 0);
-  }
+  });
 
   return;
 }
@@ -441,10 +413,7 @@ void test_xarray() {
     }
   }
 
-  TimerRecorder a("xarray");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("xarray", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -461,7 +430,7 @@ void test_xarray() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0);
-  }
+  });
 }
 
 template <class T>
@@ -480,10 +449,7 @@ void test_xtensor() {
     }
   }
 
-  TimerRecorder a("xtensor");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("xtensor", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -500,7 +466,7 @@ void test_xtensor() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0);
-  }
+  });
 }
 
 int main(int args, char* argv[]) {
@@ -546,6 +512,7 @@ int main(int args, char* argv[]) {
     test_xarray<double>();
   }
   TimerRecorder::SaveSpeedResult("2d_speed_result.csv");
+  TimerRecorder::SaveDetailResult("2d_speed_detail");
   std::cout << "test complete" << std::endl;
 
   return 0;
@@ -55,10 +55,7 @@ void test_norm() {
     }
   }
 
-  TimerRecorder a("** 3d");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("** 3d", [&] {
     if constexpr (do_add) {
       for (size_t i = 0; i < dim1; i++) {
         for (size_t j = 0; j < dim2; j++) {
@@ -100,7 +97,7 @@ void test_norm() {
     }
 
     val = data3_[0][0][0];
-  }
+  });
 
   free_3d_array(data1_, dim1, dim2);
   free_3d_array(data2_, dim1, dim2);
@@ -124,10 +121,7 @@ void test_simd() {
     data4_[i] = 4;
   }
 
-  TimerRecorder a("simd 1d");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("simd 1d", [&] {
     if constexpr (do_add) {
       md::simd_add<T, md::aligned_policy>(data1_, data2_, data3_, total_element);
     }
@@ -145,7 +139,7 @@ void test_simd() {
     }
 
     val = data3_[0];
-  }
+  });
 
   allocator_.deallocate(data1_);
   allocator_.deallocate(data2_);
@@ -165,10 +159,7 @@ void test_mdvector_expr() {
   data2_.set_value(2);
   data4_.set_value(3);
 
-  TimerRecorder a("mdvector");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("mdvector", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -185,7 +176,7 @@ void test_mdvector_expr() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0, 0);
-  }
+  });
 }
 
 template <class T, size_t N1, size_t N2, size_t N3>
@@ -200,10 +191,7 @@ void test_mdarray_expr() {
   data2_.set_value(2);
   data4_.set_value(3);
 
-  TimerRecorder a("mdarray");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("mdarray", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -220,7 +208,7 @@ void test_mdarray_expr() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0, 0);
-  }
+  });
 }
 
 void test_eigen() {
@@ -243,10 +231,7 @@ void test_eigen() {
     }
   }
 
-  TimerRecorder a("eigen");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<double>("eigen", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -263,7 +248,7 @@ void test_eigen() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0, 0);
-  }
+  });
 }
 
 template <class T>
@@ -284,10 +269,7 @@ void test_xarray() {
     }
   }
 
-  TimerRecorder a("xarray");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("xarray", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -304,7 +286,7 @@ void test_xarray() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0, 0);
-  }
+  });
 }
 
 template <class T>
@@ -325,10 +307,7 @@ void test_xtensor() {
     }
   }
 
-  TimerRecorder a("xtensor");
-
-  size_t k = 0;
-  while (k++ < loop) {
+  TimerRecorder::Measure<T>("xtensor", [&] {
     if constexpr (do_add) {
       data3_ = data1_ + data2_;
     }
@@ -345,7 +324,7 @@ void test_xtensor() {
       data3_ = data1_ / data2_;
     }
     val = data3_(0, 0, 0);
-  }
+  });
 }
 
 int main(int args, char* argv[]) {
@@ -394,6 +373,7 @@ int main(int args, char* argv[]) {
   }
 
   TimerRecorder::SaveSpeedResult("3d_speed_result.csv");
+  TimerRecorder::SaveDetailResult("3d_speed_detail");
   std::cout << "test complete" << std::endl;
 
   return 0;
@@ -1,7 +1,6 @@
 #ifndef HEADER_TIME_COST_H_
 #define HEADER_TIME_COST_H_
 
-#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -13,39 +12,47 @@ using std::string;
 using std::to_string;
 
 //
+#include "../common/bench.h"
 #include "test_set.h"
 
+// 各方法在各测试点上的速度 由bench::measure预热后多次采样 取中位数
 struct TimerRecorder {
-  TimerRecorder(const std::string &name) {
-    this->name_ = name;
-
-    if (speed_recorder_.find(name) == speed_recorder_.end()) {
-      speed_recorder_.insert({name, vector<double>{}});
-      method_name_.push_back(name);
-    }
-
+  // body执行一次全部启用的运算 T为元素类型 用于计算带宽
+  template <class T, class F>
+  static void Measure(const string &name, F &&body) {
     if (test_name_.size() == 0) {
+      bench::pin_to_core(options_.pin_core);
       for (const auto &it : all_test_points) {
         test_name_.push_back(to_string(it.dim1_) + "*" + to_string(it.dim2_) + "*" + to_string(it.dim3_));
       }
     }
 
-    // 获取开始时间点
-    start_ = std::chrono::high_resolution_clock::now();
-  }
+    if (speed_recorder_.find(name) == speed_recorder_.end()) {
+      speed_recorder_.insert({name, vector<double>{}});
+      method_name_.push_back(name);
+    }
 
-  ~TimerRecorder() {
-    auto end = std::chrono::high_resolution_clock::now();
+    // 每种运算读两个数组写一个数组
+    const size_t ops = do_add + do_sub + do_mul + do_div;
+    const size_t elements = total_element * ops;
+    auto res = bench::measure(to_string(dim1) + "*" + to_string(dim2) + "*" + to_string(dim3), name, elements, 3.0 * sizeof(T) * elements, body, options_);
 
-    // 计算持续时间
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start_);
-    double speed = total_cal * 1e-5 / duration.count();
+    // 与原先的速度单位一致: 运算次数 * 1e-5 / 毫秒
+    double speed = elements * 1e-5 / (res.median() * 1e-6);
 
     // 输出结果
-    std::cout << name_ << "     \t" << speed << "\n";
+    std::cout << name << "     \t" << speed << "\t" << res.ns_per_element() << " ns/elem\t" << res.gbps()
+              << " GB/s\t(min " << res.min() << " ns, p90 " << res.p90() << " ns)";
+    if (res.has_counters) {
+      for (size_t i = 0; i < bench::perf_counters::count; ++i) {
+        std::cout << "\t" << bench::perf_counters::names()[i] << "/elem " << res.counters[i];
+      }
+    }
+    std::cout << "\n";
 
     // 记录
-    speed_recorder_[name_].push_back(speed);
+    speed_recorder_[name].push_back(speed);
+    report_.add(res);
   }
 
   static inline void SaveSpeedResult(const string &path) {
@@ -67,12 +74,14 @@ struct TimerRecorder {
     }
   }
 
-  string name_ = "";
-#ifdef _WIN32
-  std::chrono::steady_clock::time_point start_;
-#else
-  std::chrono::_V2::system_clock::time_point start_;
-#endif
+  // 逐个样本的明细 path为不带扩展名的路径 同时写出.csv与.json
+  static inline void SaveDetailResult(const string &path) {
+    report_.save_csv(path + ".csv");
+    report_.save_json(path + ".json");
+  }
+
+  static inline bench::options options_;
+  static inline bench::report report_;
 
   static inline vector<string> test_name_;
   static inline vector<string> method_name_;
@@ -0,0 +1,310 @@
+#ifndef __MDVECTOR_BENCH_H__
+#define __MDVECTOR_BENCH_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "perf_counter.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_IX86) || defined(_M_AMD64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define MDVECTOR_BENCH_HAS_TSC 1
+#endif
+
+// 速度测试的计时框架: 预热 多次采样 纳秒计时 输出中位数/最小值/百分位
+// 例: auto r = bench::measure("100*100", "mdvector", n, 3.0 * sizeof(double) * n, [&] { c = a + b; });
+namespace bench {
+
+struct options {
+  // 预热时长 使频率 缓存与分支预测进入稳定状态
+  double warmup_ms = 50.0;
+  // 单个样本的最短时长 单次执行过短时在一个样本内重复执行 减小计时误差
+  double min_sample_ms = 2.0;
+  size_t samples = 31;
+  // 每个场景全部样本合计处理的元素数 大于0时代替min_sample_ms确定样本内的执行次数
+  double work = 0.0;
+  // 绑定的核 负数表示不绑定
+  int pin_core = 0;
+  // 每个样本同时读取硬件计数器 设置环境变量MDVECTOR_BENCH_COUNTERS时默认开启
+  bool counters = std::getenv("MDVECTOR_BENCH_COUNTERS") != nullptr;
+};
+
+// 阻止编译器把结果当作未使用而删除
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+inline uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// 时间戳计数器 按固定参考频率计数 不随睿频变化 不支持时为0
+inline uint64_t ref_cycles() {
+#ifdef MDVECTOR_BENCH_HAS_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// 当前线程绑定到指定核 避免迁移带来的缓存失效 不支持时返回false
+inline bool pin_to_core(int core) {
+#if defined(__linux__)
+  if (core < 0) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)core;
+  return false;
+#endif
+}
+
+// 整个进程共用一组计数器 首次使用时打开 不可用时提示一次
+inline perf_counters& process_counters() {
+  static perf_counters counters;
+  static bool reported = false;
+  if (!reported) {
+    reported = true;
+    if (!counters.available()) {
+      std::cerr << "hardware counters unavailable (" << counters.error() << "), timing only\n";
+    }
+  }
+  return counters;
+}
+
+// 升序样本的百分位 线性插值 p取0~100
+inline double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0.0;
+  const double pos = p / 100.0 * double(sorted.size() - 1);
+  const size_t lo = size_t(pos);
+  const size_t hi = lo + 1 < sorted.size() ? lo + 1 : lo;
+  return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - double(lo));
+}
+
+struct result {
+  std::string scenario;
+  std::string name;
+  // 单次执行处理的元素数与读写的字节数
+  size_t elements = 0;
+  double bytes = 0.0;
+  // 每个样本中单次执行的纳秒数与参考周期数 均为升序
+  std::vector<double> ns;
+  std::vector<double> cycles;
+  // 每个样本内的执行次数
+  size_t iterations = 0;
+  // 每个元素的计数器值 顺序同perf_counters::names() 未采集或不可用时为nan
+  bool has_counters = false;
+  std::array<double, perf_counters::count> counters{};
+
+  double min() const { return ns.empty() ? 0.0 : ns.front(); }
+  double median() const { return percentile(ns, 50.0); }
+  double p10() const { return percentile(ns, 10.0); }
+  double p90() const { return percentile(ns, 90.0); }
+
+  double ns_per_element() const { return elements ? median() / double(elements) : 0.0; }
+  // 字节/纳秒即GB/s
+  double gbps() const { return median() > 0.0 ? bytes / median() : 0.0; }
+  double elements_per_cycle() const {
+    const double c = percentile(cycles, 50.0);
+    return c > 0.0 ? double(elements) / c : 0.0;
+  }
+};
+
+// body为一次完整的执行 返回各样本的统计
+template <class F>
+result measure(const std::string& scenario, const std::string& name, size_t elements, double bytes, F&& body,
+               const options& opt = {}) {
+  result res;
+  res.scenario = scenario;
+  res.name = name;
+  res.elements = elements;
+  res.bytes = bytes;
+
+  // 预热 同时估计单次时长
+  size_t runs = 0;
+  const uint64_t warmup_begin = now_ns();
+  uint64_t elapsed = 0;
+  do {
+    body();
+    ++runs;
+    elapsed = now_ns() - warmup_begin;
+  } while (elapsed < uint64_t(opt.warmup_ms * 1e6));
+
+  const double single = double(elapsed) / double(runs);
+  const double target = opt.min_sample_ms * 1e6;
+  res.iterations = single >= target ? 1 : size_t(target / single) + 1;
+  if (opt.work > 0.0) {
+    const double per_sample = opt.work / double(opt.samples ? opt.samples : 1);
+    res.iterations = std::max<size_t>(1, size_t(std::ceil(per_sample / double(elements ? elements : 1))));
+  }
+
+  perf_counters* pc = opt.counters ? &process_counters() : nullptr;
+  if (pc && !pc->available()) pc = nullptr;
+  if (pc) pc->clear();
+
+  res.ns.reserve(opt.samples);
+  res.cycles.reserve(opt.samples);
+  for (size_t s = 0; s < opt.samples; ++s) {
+    if (pc) pc->start();
+    const uint64_t c0 = ref_cycles();
+    const uint64_t t0 = now_ns();
+    for (size_t i = 0; i < res.iterations; ++i) body();
+    const uint64_t t1 = now_ns();
+    const uint64_t c1 = ref_cycles();
+    if (pc) pc->stop();
+    res.ns.push_back(double(t1 - t0) / double(res.iterations));
+    res.cycles.push_back(double(c1 - c0) / double(res.iterations));
+  }
+
+  if (pc) {
+    res.has_counters = true;
+    const double n = double(opt.samples) * double(res.iterations) * double(elements ? elements : 1);
+    for (size_t i = 0; i < perf_counters::count; ++i) {
+      res.counters[i] = pc->available(i) ? pc->total(i) / n : std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  std::sort(res.ns.begin(), res.ns.end());
+  std::sort(res.cycles.begin(), res.cycles.end());
+  return res;
+}
+
+// 汇总全部结果 输出表格 CSV与JSON
+class report {
+ public:
+  void add(const result& r) { results_.push_back(r); }
+
+  const std::vector<result>& results() const { return results_; }
+
+  // 前两列的宽度由print按内容确定
+  static void print_header(std::ostream& os, bool counters = false, int scenario_width = 12, int method_width = 12) {
+    os << std::left << std::setw(scenario_width) << "scenario" << std::setw(method_width) << "method" << std::right
+       << std::setw(12) << "median ns" << std::setw(12) << "min ns" << std::setw(12) << "p90 ns" << std::setw(12)
+       << "ns/elem" << std::setw(10) << "GB/s" << std::setw(12) << "elem/cycle";
+    // 计数器按每个元素给出
+    if (counters) {
+      for (const char* name : perf_counters::names()) os << std::setw(15) << name;
+    }
+    os << "\n";
+  }
+
+  static void print_row(std::ostream& os, const result& r, int scenario_width = 12, int method_width = 12) {
+    os << std::left << std::setw(scenario_width) << r.scenario << std::setw(method_width) << r.name << std::right
+       << std::fixed << std::setprecision(1) << std::setw(12) << r.median() << std::setw(12) << r.min()
+       << std::setw(12) << r.p90() << std::setprecision(4) << std::setw(12) << r.ns_per_element()
+       << std::setprecision(2) << std::setw(10) << r.gbps() << std::setprecision(3) << std::setw(12)
+       << r.elements_per_cycle();
+    if (r.has_counters) {
+      for (double v : r.counters) {
+        if (std::isnan(v)) {
+          os << std::setw(15) << "n/a";
+        } else {
+          os << std::setw(15) << v;
+        }
+      }
+    }
+    os << "\n" << std::defaultfloat;
+  }
+
+  void print(std::ostream& os = std::cout) const {
+    bool counters = false;
+    int scenario_width = 12;
+    int method_width = 12;
+    for (const auto& r : results_) {
+      counters = counters || r.has_counters;
+      scenario_width = std::max(scenario_width, int(r.scenario.size()) + 2);
+      method_width = std::max(method_width, int(r.name.size()) + 2);
+    }
+    print_header(os, counters, scenario_width, method_width);
+    for (const auto& r : results_) print_row(os, r, scenario_width, method_width);
+  }
+
+  void save_csv(const std::string& path) const {
+    std::ofstream out(path);
+    out << "scenario,method,elements,bytes,iterations,samples,min_ns,p10_ns,median_ns,p90_ns,ns_per_element,gbps,"
+           "elements_per_cycle";
+    for (const char* name : perf_counters::names()) out << "," << name << "_per_element";
+    out << "\n";
+    for (const auto& r : results_) {
+      out << r.scenario << "," << r.name << "," << r.elements << "," << r.bytes << "," << r.iterations << ","
+          << r.ns.size() << "," << r.min() << "," << r.p10() << "," << r.median() << "," << r.p90() << ","
+          << r.ns_per_element() << "," << r.gbps() << "," << r.elements_per_cycle();
+      for (double v : r.counters) {
+        out << ",";
+        if (r.has_counters && !std::isnan(v)) out << v;
+      }
+      out << "\n";
+    }
+  }
+
+  // 保留全部样本 供之后与基线比较
+  void save_json(const std::string& path) const {
+    std::ofstream out(path);
+    out << "{\n  \"results\": [";
+    for (size_t i = 0; i < results_.size(); ++i) {
+      const auto& r = results_[i];
+      out << (i ? "," : "") << "\n    {\"scenario\": " << quote(r.scenario) << ", \"method\": " << quote(r.name)
+          << ", \"elements\": " << r.elements << ", \"bytes\": " << r.bytes << ", \"iterations\": " << r.iterations
+          << ", \"median_ns\": " << r.median() << ", \"min_ns\": " << r.min() << ", \"p10_ns\": " << r.p10()
+          << ", \"p90_ns\": " << r.p90() << ", \"ns_per_element\": " << r.ns_per_element()
+          << ", \"gbps\": " << r.gbps() << ", \"elements_per_cycle\": " << r.elements_per_cycle()
+          << counters_json(r) << ", \"samples_ns\": [";
+      for (size_t s = 0; s < r.ns.size(); ++s) out << (s ? ", " : "") << r.ns[s];
+      out << "]}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+ private:
+  static std::string counters_json(const result& r) {
+    if (!r.has_counters) return "";
+    std::string res = ", \"counters_per_element\": {";
+    bool first = true;
+    for (size_t i = 0; i < perf_counters::count; ++i) {
+      if (std::isnan(r.counters[i])) continue;
+      res += (first ? "" : ", ") + quote(perf_counters::names()[i]) + ": " + std::to_string(r.counters[i]);
+      first = false;
+    }
+    return res + "}";
+  }
+
+  static std::string quote(const std::string& s) {
+    std::string res = "\"";
+    for (char c : s) {
+      if (c == '"' || c == '\\') res += '\\';
+      res += c;
+    }
+    return res + "\"";
+  }
+
+  std::vector<result> results_;
+};
+
+}  // namespace bench
+
+#endif  // __MDVECTOR_BENCH_H__
@@ -0,0 +1,361 @@
+#ifndef __MDVECTOR_BENCH_COMPARE_H__
+#define __MDVECTOR_BENCH_COMPARE_H__
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+
+// 与基线结果逐场景比较 基线为report::save_json写出的文件 其中保留了全部样本
+// 显著性用Mann-Whitney U检验 加速比与置信区间用Hodges-Lehmann估计 均不假设耗时服从正态分布
+namespace bench {
+
+// 读取report::save_json的输出 只取比较需要的字段
+class result_reader {
+ public:
+  static std::vector<result> load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open baseline '" + path + "'");
+    std::stringstream ss;
+    ss << in.rdbuf();
+    result_reader reader(ss.str(), path);
+    return reader.parse();
+  }
+
+ private:
+  result_reader(std::string text, std::string path) : text_(std::move(text)), path_(std::move(path)) {}
+
+  std::vector<result> parse() {
+    std::vector<result> res;
+    expect('{');
+    bool found = false;
+    if (!try_consume('}')) {
+      do {
+        const std::string key = parse_string();
+        expect(':');
+        if (key == "results") {
+          found = true;
+          expect('[');
+          if (!try_consume(']')) {
+            do {
+              res.push_back(parse_result());
+            } while (try_consume(','));
+            expect(']');
+          }
+        } else {
+          skip_value();
+        }
+      } while (try_consume(','));
+      expect('}');
+    }
+    if (!found) fail("missing \"results\"");
+    return res;
+  }
+
+  result parse_result() {
+    result r;
+    expect('{');
+    if (try_consume('}')) return r;
+    do {
+      const std::string key = parse_string();
+      expect(':');
+      if (key == "scenario") {
+        r.scenario = parse_string();
+      } else if (key == "method") {
+        r.name = parse_string();
+      } else if (key == "elements") {
+        r.elements = size_t(parse_number());
+      } else if (key == "bytes") {
+        r.bytes = parse_number();
+      } else if (key == "iterations") {
+        r.iterations = size_t(parse_number());
+      } else if (key == "samples_ns") {
+        expect('[');
+        if (!try_consume(']')) {
+          do {
+            r.ns.push_back(parse_number());
+          } while (try_consume(','));
+          expect(']');
+        }
+      } else {
+        skip_value();
+      }
+    } while (try_consume(','));
+    expect('}');
+    std::sort(r.ns.begin(), r.ns.end());
+    return r;
+  }
+
+  void skip_ws() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+  }
+
+  bool try_consume(char c) {
+    skip_ws();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c) {
+    if (!try_consume(c)) fail(std::string("expected '") + c + "'");
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string res;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ++pos_;
+      res += text_[pos_++];
+    }
+    expect('"');
+    return res;
+  }
+
+  double parse_number() {
+    skip_ws();
+    const char* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    const double res = std::strtod(begin, &end);
+    if (end == begin) fail("expected a number");
+    pos_ += size_t(end - begin);
+    return res;
+  }
+
+  // 跳过不需要的值 包括嵌套的对象与数组
+  void skip_value() {
+    skip_ws();
+    if (pos_ >= text_.size()) fail("unexpected end");
+    const char c = text_[pos_];
+    if (c == '"') {
+      parse_string();
+    } else if (c == '{' || c == '[') {
+      const char close = c == '{' ? '}' : ']';
+      ++pos_;
+      if (try_consume(close)) return;
+      do {
+        if (c == '{') {
+          parse_string();
+          expect(':');
+        }
+        skip_value();
+      } while (try_consume(','));
+      expect(close);
+    } else if (std::isalpha(static_cast<unsigned char>(c))) {
+      while (pos_ < text_.size() && std::isalpha(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    } else {
+      parse_number();
+    }
+  }
+
+  [[noreturn]] void fail(const std::string& what) const {
+    throw std::runtime_error(path_ + ": " + what + " at offset " + std::to_string(pos_));
+  }
+
+  std::string text_;
+  std::string path_;
+  size_t pos_ = 0;
+};
+
+struct compare_options {
+  // 加速比偏离1超过该比例且显著时才标记 0.05即5%
+  double threshold = 0.05;
+  // 显著性水平 置信区间取1 - alpha
+  double alpha = 0.05;
+};
+
+struct comparison {
+  enum class verdict { same, faster, slower, missing };
+
+  std::string scenario;
+  std::string name;
+  double baseline_median = 0.0;
+  double current_median = 0.0;
+  // 基线耗时 / 当前耗时 大于1表示变快
+  double speedup = 1.0;
+  double lower = 1.0;
+  double upper = 1.0;
+  double p_value = 1.0;
+  verdict result = verdict::missing;
+  // missing时区分: true为基线中有而本次没有运行 false为基线中没有
+  bool baseline_only = false;
+};
+
+// 标准正态分布的双侧分位数 erfc(z / sqrt(2)) = alpha 二分求解
+inline double normal_quantile(double alpha) {
+  double lo = 0.0;
+  double hi = 10.0;
+  for (int i = 0; i < 100; ++i) {
+    const double mid = 0.5 * (lo + hi);
+    if (std::erfc(mid / std::sqrt(2.0)) > alpha) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return 0.5 * (lo + hi);
+}
+
+// 双侧Mann-Whitney U检验 正态近似 含并列修正与连续性修正 样本较少时p值偏保守
+inline double mann_whitney_p(const std::vector<double>& a, const std::vector<double>& b) {
+  const size_t n1 = a.size();
+  const size_t n2 = b.size();
+  if (n1 == 0 || n2 == 0) return 1.0;
+
+  std::vector<std::pair<double, int>> pooled;
+  pooled.reserve(n1 + n2);
+  for (double v : a) pooled.push_back({v, 0});
+  for (double v : b) pooled.push_back({v, 1});
+  std::sort(pooled.begin(), pooled.end());
+
+  // 并列的值取平均秩
+  const double n = double(n1 + n2);
+  double rank_sum = 0.0;
+  double ties = 0.0;
+  for (size_t i = 0; i < pooled.size();) {
+    size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) ++j;
+    const double rank = 0.5 * double(i + 1 + j);
+    for (size_t k = i; k < j; ++k) {
+      if (pooled[k].second == 0) rank_sum += rank;
+    }
+    const double t = double(j - i);
+    ties += t * t * t - t;
+    i = j;
+  }
+
+  const double u = rank_sum - double(n1) * double(n1 + 1) / 2.0;
+  const double mu = double(n1) * double(n2) / 2.0;
+  const double sigma = std::sqrt(double(n1) * double(n2) / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0))));
+  if (sigma == 0.0) return 1.0;
+  const double z = std::max(0.0, std::fabs(u - mu) - 0.5) / sigma;
+  return std::erfc(z / std::sqrt(2.0));
+}
+
+// 比较一对结果 加速比取log(基线/当前)两两差值的中位数 区间取与U检验对应的秩次
+inline comparison compare(const result& baseline, const result& current, const compare_options& opt = {}) {
+  comparison res;
+  res.scenario = current.scenario;
+  res.name = current.name;
+  res.baseline_median = baseline.median();
+  res.current_median = current.median();
+  if (baseline.ns.empty() || current.ns.empty()) return res;
+
+  std::vector<double> diffs;
+  diffs.reserve(baseline.ns.size() * current.ns.size());
+  for (double b : baseline.ns) {
+    for (double c : current.ns) diffs.push_back(std::log(b) - std::log(c));
+  }
+  std::sort(diffs.begin(), diffs.end());
+
+  const double m = double(diffs.size());
+  const double n1 = double(baseline.ns.size());
+  const double n2 = double(current.ns.size());
+  const double z = normal_quantile(opt.alpha);
+  // 区间为第k小与第m - k + 1小的差值(从1计) 样本太少时k不足1 取全部差值的范围
+  const double k = std::floor(m / 2.0 - z * std::sqrt(n1 * n2 * (n1 + n2 + 1.0) / 12.0));
+  const size_t lo = k >= 1.0 ? size_t(k) - 1 : 0;
+  const size_t hi = diffs.size() - 1 - lo;
+
+  res.speedup = std::exp(percentile(diffs, 50.0));
+  res.lower = std::exp(diffs[lo]);
+  res.upper = std::exp(diffs[hi]);
+  res.p_value = mann_whitney_p(baseline.ns, current.ns);
+
+  res.result = comparison::verdict::same;
+  if (res.p_value < opt.alpha) {
+    if (res.speedup < 1.0 - opt.threshold) res.result = comparison::verdict::slower;
+    if (res.speedup > 1.0 + opt.threshold) res.result = comparison::verdict::faster;
+  }
+  return res;
+}
+
+// 按场景与方法名配对 只出现在一边的场景记为missing 基线独有的排在最后
+inline std::vector<comparison> compare(const std::vector<result>& baseline, const std::vector<result>& current,
+                                       const compare_options& opt = {}) {
+  const auto same = [](const result& a, const result& b) { return a.scenario == b.scenario && a.name == b.name; };
+  std::vector<comparison> res;
+  for (const auto& c : current) {
+    const auto b = std::find_if(baseline.begin(), baseline.end(), [&](const result& r) { return same(r, c); });
+    if (b == baseline.end()) {
+      comparison missing;
+      missing.scenario = c.scenario;
+      missing.name = c.name;
+      missing.current_median = c.median();
+      res.push_back(missing);
+    } else {
+      res.push_back(compare(*b, c, opt));
+    }
+  }
+  for (const auto& b : baseline) {
+    if (std::any_of(current.begin(), current.end(), [&](const result& r) { return same(b, r); })) continue;
+    comparison missing;
+    missing.scenario = b.scenario;
+    missing.name = b.name;
+    missing.baseline_median = b.median();
+    missing.baseline_only = true;
+    res.push_back(missing);
+  }
+  return res;
+}
+
+inline bool has_regression(const std::vector<comparison>& res) {
+  return std::any_of(res.begin(), res.end(),
+                     [](const comparison& c) { return c.result == comparison::verdict::slower; });
+}
+
+inline void print_comparison(const std::vector<comparison>& res, const compare_options& opt = {},
+                             std::ostream& os = std::cout) {
+  int scenario_width = 12;
+  int method_width = 12;
+  for (const auto& c : res) {
+    scenario_width = std::max(scenario_width, int(c.scenario.size()) + 2);
+    method_width = std::max(method_width, int(c.name.size()) + 2);
+  }
+  const int ci = int(std::lround((1.0 - opt.alpha) * 100.0));
+  os << std::left << std::setw(scenario_width) << "scenario" << std::setw(method_width) << "method" << std::right
+     << std::setw(14) << "baseline ns" << std::setw(14) << "current ns" << std::setw(10) << "speedup"
+     << std::setw(20) << (std::to_string(ci) + "% interval") << std::setw(10) << "p" << "  verdict\n";
+  for (const auto& c : res) {
+    os << std::left << std::setw(scenario_width) << c.scenario << std::setw(method_width) << c.name << std::right
+       << std::fixed << std::setprecision(1) << std::setw(14) << c.baseline_median << std::setw(14)
+       << c.current_median;
+    if (c.result == comparison::verdict::missing) {
+      os << std::setw(10) << "-" << std::setw(20) << "-" << std::setw(10) << "-"
+         << (c.baseline_only ? "  missing (not run)\n" : "  missing (not in baseline)\n");
+      continue;
+    }
+    std::ostringstream interval;
+    interval << std::fixed << std::setprecision(3) << "[" << c.lower << ", " << c.upper << "]";
+    os << std::setprecision(3) << std::setw(9) << c.speedup << "x" << std::setw(20) << interval.str()
+       << std::setprecision(4) << std::setw(10) << c.p_value;
+    switch (c.result) {
+      case comparison::verdict::slower:
+        os << "  SLOWER";
+        break;
+      case comparison::verdict::faster:
+        os << "  faster";
+        break;
+      default:
+        break;
+    }
+    os << "\n";
+  }
+  os << std::defaultfloat;
+}
+
+}  // namespace bench
+
+#endif  // __MDVECTOR_BENCH_COMPARE_H__
@@ -0,0 +1,133 @@
+#ifndef __MDVECTOR_PERF_COUNTER_H__
+#define __MDVECTOR_PERF_COUNTER_H__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+// Linux perf_event_open硬件计数器 只统计用户态 各事件单独打开 某个事件不可用时其余照常计数
+// 不支持的平台或没有权限时(如perf_event_paranoid过高 容器中禁用) 全部标记为不可用
+namespace bench {
+
+class perf_counters {
+ public:
+  static constexpr size_t count = 6;
+
+  static const std::array<const char*, count>& names() {
+    static const std::array<const char*, count> res = {"cycles",      "instructions", "l1d_misses",
+                                                       "llc_misses",  "dtlb_misses",  "branch_misses"};
+    return res;
+  }
+
+  perf_counters() {
+#if defined(__linux__)
+    const uint64_t l1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const uint64_t dtlb = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const std::array<std::pair<uint32_t, uint64_t>, count> events = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, l1d},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HW_CACHE, dtlb},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+    for (size_t i = 0; i < count; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = events[i].first;
+      attr.config = events[i].second;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fd_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fd_[i] < 0 && error_.empty()) {
+        error_ = std::string(names()[i]) + ": " + std::strerror(errno);
+      }
+    }
+#else
+    error_ = "perf_event_open is only available on Linux";
+#endif
+  }
+
+  ~perf_counters() {
+#if defined(__linux__)
+    for (int fd : fd_) {
+      if (fd >= 0) close(fd);
+    }
+#endif
+  }
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  // 至少一个事件可用
+  bool available() const {
+    for (int fd : fd_) {
+      if (fd >= 0) return true;
+    }
+    return false;
+  }
+
+  bool available(size_t i) const { return fd_[i] >= 0; }
+
+  // 第一个打开失败的事件及原因
+  const std::string& error() const { return error_; }
+
+  // RESET只清零计数值 time_enabled与time_running从打开起一直累加 记下起点供stop取本次的增量
+  void start() {
+#if defined(__linux__)
+    for (size_t i = 0; i < count; ++i) {
+      if (fd_[i] < 0) continue;
+      ioctl(fd_[i], PERF_EVENT_IOC_RESET, 0);
+      uint64_t v[3] = {0, 0, 0};
+      if (read(fd_[i], v, sizeof(v)) != ssize_t(sizeof(v))) v[1] = v[2] = 0;
+      enabled_[i] = v[1];
+      running_[i] = v[2];
+      ioctl(fd_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // 停止计数并累加到total 事件被复用时按本次实际计数时间的比例放大
+  void stop() {
+#if defined(__linux__)
+    for (size_t i = 0; i < count; ++i) {
+      if (fd_[i] < 0) continue;
+      ioctl(fd_[i], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t v[3] = {0, 0, 0};
+      if (read(fd_[i], v, sizeof(v)) != ssize_t(sizeof(v)) || v[2] <= running_[i]) continue;
+      total_[i] += double(v[0]) * double(v[1] - enabled_[i]) / double(v[2] - running_[i]);
+    }
+#endif
+  }
+
+  void clear() { total_.fill(0.0); }
+
+  double total(size_t i) const { return total_[i]; }
+
+ private:
+  std::array<int, count> fd_{-1, -1, -1, -1, -1, -1};
+  std::array<double, count> total_{};
+  // start时的time_enabled与time_running
+  std::array<uint64_t, count> enabled_{};
+  std::array<uint64_t, count> running_{};
+  std::string error_;
+};
+
+}  // namespace bench
+
+#endif  // __MDVECTOR_PERF_COUNTER_H__
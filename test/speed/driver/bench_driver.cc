@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//
+#include "mdvector.h"
+
+//
+#include "../common/bench.h"
+#include "../common/compare.h"
+
+// 统一的速度测试入口 秩 形状 元素类型 布局 运算与工作量均由命令行或配置文件指定 无需重新编译
+// 全部场景汇总为一张表 同时写出CSV与JSON
+//
+// 用法: bench_driver [--key value | --key=value]...
+//   --config   配置文件 每行一个"key = value" #之后为注释 命令行中位于其后的选项覆盖文件中的值
+//   --shape    形状列表 如 1000000,1000x1000,100x100x100 给出时忽略rank与size
+//   --rank     秩列表 1~6 与size组合为各维近似相等的形状 默认1,2,3
+//   --size     元素数列表 默认1e4,1e6
+//   --dtype    float,double 默认double
+//   --layout   right,left 默认right
+//   --op       运算列表 默认arith 可用的运算与分组见usage()
+//   --work     每个场景全部样本合计处理的元素数 如3e8 默认按--min-sample-ms确定
+//   --samples --warmup-ms --min-sample-ms --pin --counters  同bench::options
+//   --output   结果文件的前缀 默认bench_result
+//   --baseline 此前写出的JSON结果 逐场景比较并给出加速比 置信区间与p值 未指定场景时重跑基线中的全部场景
+//   --threshold 显著且变慢超过该比例时判为退化 默认0.05   --alpha 显著性水平 默认0.05
+// 存在退化时返回2 参数错误返回1
+// 例: bench_driver --rank 2,3 --size 1e6 --dtype float,double --op add,fused,span_add,sqrt --work 3e8
+//     bench_driver --baseline release_1.2.json --threshold 0.1
+
+struct config {
+  std::vector<std::vector<size_t>> shapes;
+  std::vector<size_t> ranks{1, 2, 3};
+  std::vector<double> sizes{1e4, 1e6};
+  std::vector<std::string> dtypes{"double"};
+  std::vector<std::string> layouts{"right"};
+  std::vector<std::string> ops;
+  std::string output = "bench_result";
+  bench::options opt;
+  std::string baseline;
+  bench::compare_options compare;
+  // 是否指定了场景 未指定且给出基线时按基线的场景运行
+  bool scenarios_set = false;
+};
+
+// 一种元素类型 布局与形状下要运行的全部运算
+struct job {
+  std::string dtype;
+  std::string layout;
+  std::vector<size_t> shape;
+  std::vector<std::string> ops;
+};
+
+struct kernel {
+  std::string name;
+  // 每个元素的读写次数 读与写各计一次
+  size_t streams;
+  std::function<void()> body;
+};
+
+const std::vector<std::string> arith_ops = {"add", "sub", "mul", "div"};
+const std::vector<std::string> chain_ops = {"fused", "scalar", "compound", "span_add", "span_compound"};
+const std::vector<std::string> math_ops = {"sqrt", "exp", "pow", "ln", "log10", "cos", "sin", "tanh"};
+
+void usage(std::ostream& os) {
+  os << "usage: bench_driver [--config file] [--shape 1000x1000,...] [--rank 1,2,3] [--size 1e4,1e6]\n"
+        "                    [--dtype float,double] [--layout right,left] [--op list] [--work elements]\n"
+        "                    [--samples n] [--warmup-ms ms] [--min-sample-ms ms] [--pin core] [--counters]\n"
+        "                    [--output prefix] [--baseline file] [--threshold ratio] [--alpha level]\n"
+        "operations:";
+  for (const auto* group : {&arith_ops, &chain_ops, &math_ops}) {
+    for (const auto& op : *group) os << " " << op;
+  }
+  os << "\ngroups: arith chain math all\n";
+}
+
+std::string trim(const std::string& s) {
+  const size_t begin = s.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return "";
+  return s.substr(begin, s.find_last_not_of(" \t\r\n") - begin + 1);
+}
+
+std::vector<std::string> split(const std::string& s, char sep) {
+  std::vector<std::string> res;
+  size_t begin = 0;
+  while (begin <= s.size()) {
+    const size_t end = std::min(s.find(sep, begin), s.size());
+    const std::string item = trim(s.substr(begin, end - begin));
+    if (!item.empty()) res.push_back(item);
+    begin = end + 1;
+  }
+  return res;
+}
+
+// 接受1e6这样的写法
+double to_number(const std::string& key, const std::string& s) {
+  size_t pos = 0;
+  double res = 0.0;
+  try {
+    res = std::stod(s, &pos);
+  } catch (const std::exception&) {
+    pos = 0;
+  }
+  if (pos != s.size() || res < 0.0) {
+    throw std::invalid_argument("--" + key + ": invalid number '" + s + "'");
+  }
+  return res;
+}
+
+std::vector<size_t> parse_shape(const std::string& s) {
+  std::vector<size_t> res;
+  for (const auto& d : split(s, 'x')) res.push_back(size_t(to_number("shape", d)));
+  if (res.empty() || res.size() > 6) {
+    throw std::invalid_argument("--shape: rank of '" + s + "' must be 1~6");
+  }
+  return res;
+}
+
+void check_choice(const std::string& key, const std::string& value, const std::vector<std::string>& choices) {
+  if (std::find(choices.begin(), choices.end(), value) == choices.end()) {
+    throw std::invalid_argument("--" + key + ": unknown value '" + value + "'");
+  }
+}
+
+// 单个运算名或分组名展开为运算列表
+std::vector<std::string> expand_op(const std::string& s) {
+  std::vector<std::string> res;
+  if (s == "arith" || s == "all") res.insert(res.end(), arith_ops.begin(), arith_ops.end());
+  if (s == "chain" || s == "all") res.insert(res.end(), chain_ops.begin(), chain_ops.end());
+  if (s == "math" || s == "all") res.insert(res.end(), math_ops.begin(), math_ops.end());
+  if (res.empty()) {
+    std::vector<std::string> known = arith_ops;
+    known.insert(known.end(), chain_ops.begin(), chain_ops.end());
+    known.insert(known.end(), math_ops.begin(), math_ops.end());
+    check_choice("op", s, known);
+    res.push_back(s);
+  }
+  return res;
+}
+
+void load_config(config& cfg, const std::string& path);
+
+void set_option(config& cfg, const std::string& key, const std::string& value) {
+  for (const char* k : {"shape", "rank", "size", "dtype", "layout", "op"}) {
+    if (key == k) cfg.scenarios_set = true;
+  }
+  if (key == "config") {
+    load_config(cfg, value);
+  } else if (key == "shape") {
+    cfg.shapes.clear();
+    for (const auto& s : split(value, ',')) cfg.shapes.push_back(parse_shape(s));
+  } else if (key == "rank") {
+    cfg.ranks.clear();
+    for (const auto& s : split(value, ',')) {
+      const size_t r = size_t(to_number(key, s));
+      if (r < 1 || r > 6) throw std::invalid_argument("--rank: must be 1~6");
+      cfg.ranks.push_back(r);
+    }
+  } else if (key == "size") {
+    cfg.sizes.clear();
+    for (const auto& s : split(value, ',')) cfg.sizes.push_back(to_number(key, s));
+  } else if (key == "dtype") {
+    cfg.dtypes = split(value, ',');
+    for (const auto& s : cfg.dtypes) check_choice(key, s, {"float", "double"});
+  } else if (key == "layout") {
+    cfg.layouts = split(value, ',');
+    for (const auto& s : cfg.layouts) check_choice(key, s, {"right", "left"});
+  } else if (key == "op") {
+    cfg.ops.clear();
+    for (const auto& s : split(value, ',')) {
+      const auto group = expand_op(s);
+      cfg.ops.insert(cfg.ops.end(), group.begin(), group.end());
+    }
+  } else if (key == "work") {
+    cfg.opt.work = to_number(key, value);
+  } else if (key == "samples") {
+    cfg.opt.samples = std::max<size_t>(1, size_t(to_number(key, value)));
+  } else if (key == "warmup-ms") {
+    cfg.opt.warmup_ms = to_number(key, value);
+  } else if (key == "min-sample-ms") {
+    cfg.opt.min_sample_ms = to_number(key, value);
+  } else if (key == "pin") {
+    cfg.opt.pin_core = std::atoi(value.c_str());
+  } else if (key == "counters") {
+    cfg.opt.counters = value != "0" && value != "false" && value != "off";
+  } else if (key == "output") {
+    cfg.output = value;
+  } else if (key == "baseline") {
+    cfg.baseline = value;
+  } else if (key == "threshold") {
+    cfg.compare.threshold = to_number(key, value);
+  } else if (key == "alpha") {
+    cfg.compare.alpha = to_number(key, value);
+    if (cfg.compare.alpha <= 0.0 || cfg.compare.alpha >= 1.0) {
+      throw std::invalid_argument("--alpha: must be in (0, 1)");
+    }
+  } else {
+    throw std::invalid_argument("unknown option '" + key + "'");
+  }
+}
+
+void load_config(config& cfg, const std::string& path) {
+  std::ifstream in(path);
+  if (!in) throw std::invalid_argument("cannot open config file '" + path + "'");
+  std::string line;
+  while (std::getline(in, line)) {
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty()) continue;
+    const size_t eq = line.find('=');
+    if (eq == std::string::npos) throw std::invalid_argument(path + ": expected 'key = value': " + line);
+    set_option(cfg, trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+  }
+}
+
+config parse_args(int args, char* argv[]) {
+  config cfg;
+  for (int i = 1; i < args; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--", 0) != 0) throw std::invalid_argument("unexpected argument '" + arg + "'");
+    arg = arg.substr(2);
+    const size_t eq = arg.find('=');
+    if (eq != std::string::npos) {
+      set_option(cfg, arg.substr(0, eq), arg.substr(eq + 1));
+    } else if (arg == "counters") {
+      // 开关可以不带值
+      set_option(cfg, arg, "1");
+    } else if (i + 1 < args) {
+      set_option(cfg, arg, argv[++i]);
+    } else {
+      throw std::invalid_argument("--" + arg + ": missing value");
+    }
+  }
+  if (cfg.ops.empty()) cfg.ops = arith_ops;
+  if (cfg.shapes.empty()) {
+    // 各维长度取n的r次方根 实际元素数与n略有出入
+    for (double n : cfg.sizes) {
+      for (size_t r : cfg.ranks) {
+        const size_t d = std::max<size_t>(1, size_t(std::pow(n, 1.0 / double(r)) + 0.5));
+        cfg.shapes.push_back(std::vector<size_t>(r, d));
+      }
+    }
+  }
+  return cfg;
+}
+
+std::string shape_name(const std::vector<size_t>& shape) {
+  std::string res;
+  for (size_t r = 0; r < shape.size(); ++r) res += (r ? "x" : "") + std::to_string(shape[r]);
+  return res;
+}
+
+std::string scenario_name(const job& j) { return j.dtype + "/" + j.layout + "/" + shape_name(j.shape); }
+
+std::vector<job> build_jobs(const config& cfg) {
+  std::vector<job> res;
+  for (const auto& shape : cfg.shapes) {
+    for (const auto& dtype : cfg.dtypes) {
+      for (const auto& layout : cfg.layouts) res.push_back({dtype, layout, shape, cfg.ops});
+    }
+  }
+  return res;
+}
+
+// 由基线中的场景名还原要运行的场景 无法识别的场景跳过
+std::vector<job> baseline_jobs(const std::vector<bench::result>& baseline) {
+  std::vector<job> res;
+  for (const auto& r : baseline) {
+    const auto parts = split(r.scenario, '/');
+    try {
+      if (parts.size() != 3) throw std::invalid_argument("malformed scenario");
+      check_choice("dtype", parts[0], {"float", "double"});
+      check_choice("layout", parts[1], {"right", "left"});
+      if (expand_op(r.name).size() != 1) throw std::invalid_argument("not a single operation");
+      job j{parts[0], parts[1], parse_shape(parts[2]), {r.name}};
+      const auto same = std::find_if(res.begin(), res.end(),
+                                     [&](const job& it) { return scenario_name(it) == scenario_name(j); });
+      if (same == res.end()) {
+        res.push_back(j);
+      } else {
+        same->ops.push_back(r.name);
+      }
+    } catch (const std::invalid_argument&) {
+      std::cerr << "skip baseline scenario " << r.scenario << " " << r.name << "\n";
+    }
+  }
+  return res;
+}
+
+template <class T, size_t Rank, class Layout>
+void run(const job& j, const bench::options& opt, bench::report& report) {
+  const std::string scenario = scenario_name(j);
+  const auto& shape = j.shape;
+  std::array<size_t, Rank> dims;
+  std::copy(shape.begin(), shape.end(), dims.begin());
+
+  using vec = mdvector<T, Rank, Layout>;
+  vec a(dims, md::uninitialized);
+  vec b(dims, md::uninitialized);
+  vec c(dims, md::uninitialized);
+  vec d(dims, md::uninitialized);
+  // 取值落在全部数学函数的定义域内
+  a.set_value(T(1.5));
+  b.set_value(T(2.5));
+  c.set_value(T(0.5));
+  d.set_value(T(0));
+  const size_t n = a.size();
+
+  md::span<T, Rank, Layout> sa(a.begin(), dims);
+  md::span<T, Rank, Layout> sb(b.begin(), dims);
+  md::span<T, Rank, Layout> sc(c.begin(), dims);
+
+  const std::vector<kernel> kernels = {
+      {"add", 3, [&] { c = a + b; }},
+      {"sub", 3, [&] { c = a - b; }},
+      {"mul", 3, [&] { c = a * b; }},
+      {"div", 3, [&] { c = a / b; }},
+      {"fused", 4, [&] { d = a * b + c - a / b; }},
+      {"scalar", 2, [&] { c = a * T(2) + T(1); }},
+      {"compound", 3, [&] { c += a; }},
+      {"span_add", 3, [&] { sc = sa + sb; }},
+      {"span_compound", 3, [&] { sc += sa; }},
+      {"sqrt", 2, [&] { c = a.sqrt(); }},
+      {"exp", 2, [&] { c = a.exp(T(2)); }},
+      {"pow", 2, [&] { c = a.pow(T(1.5)); }},
+      {"ln", 2, [&] { c = a.ln(); }},
+      {"log10", 2, [&] { c = a.log10(); }},
+      {"cos", 2, [&] { c = a.cos(); }},
+      {"sin", 2, [&] { c = a.sin(); }},
+      {"tanh", 2, [&] { c = a.tanh(); }},
+  };
+
+  for (const auto& op : j.ops) {
+    const auto k = std::find_if(kernels.begin(), kernels.end(), [&](const kernel& it) { return it.name == op; });
+    // 复合赋值会累加 每个运算开始前恢复初值 使各运算的输入一致
+    c.set_value(T(0.5));
+    auto r = bench::measure(scenario, op, n, double(k->streams * n * sizeof(T)), k->body, opt);
+    bench::do_not_optimize(*c.begin());
+    bench::do_not_optimize(*d.begin());
+    std::cout << scenario << "\t" << op << "\t" << r.median() << " ns\t" << r.gbps() << " GB/s\n";
+    report.add(r);
+  }
+}
+
+template <class T, class Layout>
+void dispatch(const job& j, const bench::options& opt, bench::report& report) {
+  switch (j.shape.size()) {
+    case 1:
+      return run<T, 1, Layout>(j, opt, report);
+    case 2:
+      return run<T, 2, Layout>(j, opt, report);
+    case 3:
+      return run<T, 3, Layout>(j, opt, report);
+    case 4:
+      return run<T, 4, Layout>(j, opt, report);
+    case 5:
+      return run<T, 5, Layout>(j, opt, report);
+    case 6:
+      return run<T, 6, Layout>(j, opt, report);
+    default:
+      throw std::invalid_argument("rank must be 1~6");
+  }
+}
+
+template <class T>
+void dispatch(const job& j, const bench::options& opt, bench::report& report) {
+  if (j.layout == "left") {
+    dispatch<T, md::layout_left>(j, opt, report);
+  } else {
+    dispatch<T, md::layout_right>(j, opt, report);
+  }
+}
+
+int main(int args, char* argv[]) {
+  config cfg;
+  std::vector<bench::result> baseline;
+  std::vector<job> jobs;
+  try {
+    for (int i = 1; i < args; ++i) {
+      if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+        usage(std::cout);
+        return 0;
+      }
+    }
+    cfg = parse_args(args, argv);
+    if (!cfg.baseline.empty()) baseline = bench::result_reader::load(cfg.baseline);
+    jobs = !baseline.empty() && !cfg.scenarios_set ? baseline_jobs(baseline) : build_jobs(cfg);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << "\n";
+    usage(std::cerr);
+    return 1;
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+
+  md::print_simd_type();
+  bench::pin_to_core(cfg.opt.pin_core);
+
+  bench::report report;
+  for (const auto& j : jobs) {
+    if (j.dtype == "float") {
+      dispatch<float>(j, cfg.opt, report);
+    } else {
+      dispatch<double>(j, cfg.opt, report);
+    }
+  }
+
+  std::cout << "\n";
+  report.print();
+  report.save_csv(cfg.output + ".csv");
+  report.save_json(cfg.output + ".json");
+
+  if (!cfg.baseline.empty()) {
+    const auto cmp = bench::compare(baseline, report.results(), cfg.compare);
+    std::cout << "\ncompared with " << cfg.baseline << "\n";
+    bench::print_comparison(cmp, cfg.compare);
+    if (bench::has_regression(cmp)) {
+      std::cout << "regression detected" << std::endl;
+      return 2;
+    }
+  }
+
+  std::cout << "test complete" << std::endl;
+  return 0;
+}
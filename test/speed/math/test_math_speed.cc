@@ -0,0 +1,175 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+//
+#include "mdvector.h"
+
+//
+#include "../common/bench.h"
+
+// 数学函数的速度与精度
+// 每个函数分别经过标量libm循环 mdvector成员函数 span成员函数与表达式四种途径
+// 速度按每个元素的纳秒数给出 同时给出相对标量libm的加速比
+// 精度为相对long double参考值的最大ULP误差 long double与double等宽的平台上double的误差只能作为参考
+// 用法: test_math_speed [元素数...]
+// 例: test_math_speed 1000 100000 1000000
+
+struct row {
+  std::string dtype;
+  size_t size;
+  std::string function;
+  std::string form;
+  double ns_per_element;
+  double speedup;
+  double max_ulp;
+};
+
+// 以T的精度计 value与参考值相差多少个最小精度单位
+template <class T>
+double ulp_error(T value, long double ref) {
+  if (std::isnan(ref)) return std::isnan(value) ? 0.0 : std::numeric_limits<double>::infinity();
+  if (std::isinf(ref)) return (long double)value == ref ? 0.0 : std::numeric_limits<double>::infinity();
+  const long double mag = std::fabs(ref);
+  // 非规格化数的间距固定
+  const int e = mag < std::numeric_limits<T>::min() ? std::numeric_limits<T>::min_exponent - 1 : std::ilogb(mag);
+  const long double ulp = std::ldexp(1.0L, e - std::numeric_limits<T>::digits + 1);
+  return double(std::fabs((long double)value - ref) / ulp);
+}
+
+template <class T>
+double max_ulp_error(const vector_1d<T>& res, const std::vector<long double>& ref) {
+  double err = 0.0;
+  const T* p = res.begin();
+  for (size_t i = 0; i < ref.size(); ++i) err = std::max(err, ulp_error(p[i], ref[i]));
+  return err;
+}
+
+// elem: 逐元素的标量形式 同时用于libm循环与long double参考值
+// member: mdvector与span的成员函数  expr: 表达式的类外函数
+template <class T, class Elem, class Member, class Expr>
+void run_function(const std::string& dtype, size_t n, const std::string& name, double lo, double hi, Elem elem,
+                  Member member, Expr expr, const bench::options& opt, bench::report& report,
+                  std::vector<row>& rows) {
+  vector_1d<T> a({n}, md::uninitialized);
+  vector_1d<T> z({n});
+  vector_1d<T> c({n});
+  std::mt19937 gen(2024);
+  std::uniform_real_distribution<double> dist(lo, hi);
+  for (auto& v : a) v = T(dist(gen));
+  md::span<T, 1> sa(a.begin(), {n});
+
+  std::vector<long double> ref(n);
+  for (size_t i = 0; i < n; ++i) ref[i] = elem((long double)a.begin()[i]);
+
+  const T* pa = a.begin();
+  struct form {
+    std::string name;
+    size_t streams;
+    std::function<void()> body;
+  };
+  const std::vector<form> forms = {
+      {"libm", 2,
+       [&] {
+         T* pc = c.begin();
+         for (size_t i = 0; i < n; ++i) pc[i] = elem(pa[i]);
+       }},
+      {"mdvector", 2, [&] { c = member(a); }},
+      {"span", 2, [&] { c = member(sa); }},
+      // 加上全零数组使参数成为表达式 输入值不变
+      {"expr", 3, [&] { c = expr(a + z); }},
+  };
+
+  const std::string scenario = dtype + "/" + std::to_string(n);
+  double libm_ns = 0.0;
+  for (const auto& f : forms) {
+    auto r = bench::measure(scenario, name + "/" + f.name, n, double(f.streams * n * sizeof(T)), f.body, opt);
+    if (f.name == "libm") libm_ns = r.median();
+    // 计时的最后一次执行的结果即为该途径的输出
+    const double err = max_ulp_error(c, ref);
+    rows.push_back({dtype, n, name, f.name, r.ns_per_element(), r.median() > 0.0 ? libm_ns / r.median() : 0.0, err});
+    report.add(r);
+  }
+}
+
+template <class T>
+void run_all(const std::string& dtype, size_t n, const bench::options& opt, bench::report& report,
+             std::vector<row>& rows) {
+  const T y_exp = T(2);
+  const T y_pow = T(1.5);
+  run_function<T>(
+      dtype, n, "cos", -10.0, 10.0, [](auto x) { return std::cos(x); }, [](const auto& v) { return v.cos(); },
+      [](const auto& e) { return cos(e); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "sin", -10.0, 10.0, [](auto x) { return std::sin(x); }, [](const auto& v) { return v.sin(); },
+      [](const auto& e) { return sin(e); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "sqrt", 0.0, 1000.0, [](auto x) { return std::sqrt(x); }, [](const auto& v) { return v.sqrt(); },
+      [](const auto& e) { return sqrt(e); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "ln", 1e-3, 1000.0, [](auto x) { return std::log(x); }, [](const auto& v) { return v.ln(); },
+      [](const auto& e) { return ln(e); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "log10", 1e-3, 1000.0, [](auto x) { return std::log10(x); }, [](const auto& v) { return v.log10(); },
+      [](const auto& e) { return log10(e); }, opt, report, rows);
+  // exp(y)即y^x pow(y)即x^y
+  run_function<T>(
+      dtype, n, "exp(2)", -20.0, 20.0, [=](auto x) { return std::pow(decltype(x)(y_exp), x); },
+      [=](const auto& v) { return v.exp(y_exp); }, [=](const auto& e) { return exp(e, y_exp); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "pow(1.5)", 0.0, 100.0, [=](auto x) { return std::pow(x, decltype(x)(y_pow)); },
+      [=](const auto& v) { return v.pow(y_pow); }, [=](const auto& e) { return pow(e, y_pow); }, opt, report, rows);
+  run_function<T>(
+      dtype, n, "tanh", -5.0, 5.0, [](auto x) { return std::tanh(x); }, [](const auto& v) { return v.tanh(); },
+      [](const auto& e) { return tanh(e); }, opt, report, rows);
+}
+
+int main(int args, char* argv[]) {
+  md::print_simd_type();
+
+  std::vector<size_t> sizes;
+  for (int i = 1; i < args; ++i) sizes.push_back(size_t(std::atof(argv[i])));
+  if (sizes.empty()) sizes = {1000, 100000, 1000000};
+
+  bench::options opt;
+  opt.warmup_ms = 10.0;
+  opt.min_sample_ms = 2.0;
+  opt.samples = 11;
+  bench::pin_to_core(opt.pin_core);
+
+  bench::report report;
+  std::vector<row> rows;
+  for (size_t n : sizes) {
+    if (n == 0) continue;
+    run_all<float>("float", n, opt, report, rows);
+    run_all<double>("double", n, opt, report, rows);
+  }
+
+  std::cout << std::left << std::setw(8) << "dtype" << std::setw(10) << "size" << std::setw(10) << "function"
+            << std::setw(10) << "form" << std::right << std::setw(12) << "ns/elem" << std::setw(12) << "Gelem/s"
+            << std::setw(10) << "vs libm" << std::setw(12) << "max ulp" << "\n";
+  std::ofstream csv("math_speed.csv");
+  csv << "dtype,size,function,form,ns_per_element,gelem_per_s,speedup_vs_libm,max_ulp\n";
+  for (const auto& r : rows) {
+    const double gelem = r.ns_per_element > 0.0 ? 1.0 / r.ns_per_element : 0.0;
+    std::cout << std::left << std::setw(8) << r.dtype << std::setw(10) << r.size << std::setw(10) << r.function
+              << std::setw(10) << r.form << std::right << std::fixed << std::setprecision(4) << std::setw(12)
+              << r.ns_per_element << std::setw(12) << gelem << std::setprecision(2) << std::setw(10) << r.speedup
+              << std::setw(12) << r.max_ulp << "\n"
+              << std::defaultfloat;
+    csv << r.dtype << "," << r.size << "," << r.function << "," << r.form << "," << r.ns_per_element << "," << gelem
+        << "," << r.speedup << "," << r.max_ulp << "\n";
+  }
+  report.save_csv("math_speed_detail.csv");
+  report.save_json("math_speed_detail.json");
+
+  std::cout << "test complete" << std::endl;
+  return 0;
+}
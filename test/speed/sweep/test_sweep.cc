@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//
+#include "mdvector.h"
+
+//
+#include "../common/bench.h"
+
+// 数组规模从1KB按几何级数增大到数GB 依次经过L1 L2 LLC与内存
+// 每个规模先测STREAM式copy/triad得到本机实际带宽 再把各运算的带宽表示为其占比
+// 用法: test_sweep [最大工作集字节数] [相邻规模的倍数]
+// 例: test_sweep 4e9 2
+
+using T = double;
+
+struct kernel {
+  std::string name;
+  // 每个元素的读写次数(按STREAM的计法 读与写各计一次) 与运算次数
+  size_t streams;
+  size_t flops;
+  std::function<void()> body;
+};
+
+// STREAM基准 直接使用simd层的对齐读写 不经过表达式模板 也不依赖编译器自动向量化
+void stream_copy(const T* a, T* c, size_t n) {
+  using S = md::simd<T>;
+  size_t i = 0;
+  for (; i + S::pack_size <= n; i += S::pack_size) S::store(c + i, S::load(a + i));
+  if (i < n) S::mask_store(c + i, n - i, S::mask_load(a + i, n - i));
+}
+
+void stream_triad(T* a, const T* b, const T* c, T s, size_t n) {
+  using S = md::simd<T>;
+  const auto vs = S::set1(s);
+  size_t i = 0;
+  for (; i + S::pack_size <= n; i += S::pack_size) S::store(a + i, S::fma(vs, S::load(c + i), S::load(b + i)));
+  if (i < n) S::mask_store(a + i, n - i, S::fma(vs, S::mask_load(c + i, n - i), S::mask_load(b + i, n - i)));
+}
+
+std::string format_bytes(double bytes) {
+  const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+  size_t u = 0;
+  while (bytes >= 1024.0 && u + 1 < 5) {
+    bytes /= 1024.0;
+    ++u;
+  }
+  std::string res = std::to_string(bytes);
+  return res.substr(0, res.find('.') + 2) + units[u];
+}
+
+int main(int args, char* argv[]) {
+  md::print_simd_type();
+
+  const double max_bytes = args > 1 ? std::atof(argv[1]) : 4e9;
+  const double factor = args > 2 ? std::atof(argv[2]) : 2.0;
+  if (factor <= 1.0) {
+    std::cerr << "factor must be greater than 1\n";
+    return 1;
+  }
+
+  bench::options opt;
+  opt.warmup_ms = 20.0;
+  opt.min_sample_ms = 5.0;
+  opt.samples = 11;
+  bench::pin_to_core(opt.pin_core);
+
+  bench::report report;
+  std::vector<std::string> roofline_rows;
+
+  // 最多同时使用5个数组 工作集按5个数组计
+  constexpr size_t max_arrays = 5;
+  for (double bytes = 1024.0; bytes <= max_bytes; bytes *= factor) {
+    const size_t n = size_t(bytes / (max_arrays * sizeof(T))) > 0 ? size_t(bytes / (max_arrays * sizeof(T))) : 1;
+    const std::string scenario = format_bytes(double(n * max_arrays * sizeof(T)));
+
+    vector_1d<T> a({n}, md::uninitialized);
+    vector_1d<T> b({n}, md::uninitialized);
+    vector_1d<T> c({n}, md::uninitialized);
+    vector_1d<T> d({n}, md::uninitialized);
+    vector_1d<T> e({n}, md::uninitialized);
+    a.set_value(1.0);
+    b.set_value(2.0);
+    c.set_value(3.0);
+    d.set_value(4.0);
+    e.set_value(0.0);
+
+    T* pa = a.begin();
+    T* pb = b.begin();
+    T* pc = c.begin();
+    const T s = 3.0;
+    const std::vector<kernel> baselines = {
+        {"copy", 2, 0, [=] { stream_copy(pa, pc, n); }},
+        {"triad", 3, 2, [=] { stream_triad(pa, pb, pc, s, n); }},
+    };
+
+    md::span<T, 1> sa(a.begin(), {n});
+    md::span<T, 1> sb(b.begin(), {n});
+    md::span<T, 1> sc(c.begin(), {n});
+    const std::vector<kernel> kernels = {
+        {"add", 3, 1, [&] { c = a + b; }},
+        {"scalar", 2, 1, [&] { c = a * 2.0; }},
+        {"compound", 3, 1, [&] { c += a; }},
+        {"fused", 5, 6, [&] { e = a * b + c - d / b + a * 0.5; }},
+        {"span add", 3, 1, [&] { sc = sa + sb; }},
+        {"span +=", 3, 1, [&] { sc += sa; }},
+    };
+
+    double roof = 0.0;
+    for (const auto& k : baselines) {
+      auto r = bench::measure(scenario, k.name, n, double(k.streams * n * sizeof(T)), k.body, opt);
+      if (r.gbps() > roof) roof = r.gbps();
+      report.add(r);
+    }
+
+    for (const auto& k : kernels) {
+      auto r = bench::measure(scenario, k.name, n, double(k.streams * n * sizeof(T)), k.body, opt);
+      report.add(r);
+      // 带宽上限取copy与triad实测值中的较大者 这些运算的计算强度远低于屋脊点 不测计算上限
+      const double intensity = double(k.flops) / double(k.streams * sizeof(T));
+      roofline_rows.push_back(scenario + "," + k.name + "," + std::to_string(intensity) + "," +
+                              std::to_string(r.gbps()) + "," + std::to_string(roof) + "," +
+                              std::to_string(roof > 0.0 ? r.gbps() / roof : 0.0));
+      std::cout << scenario << "\t" << k.name << "\t" << r.gbps() << " GB/s\t" << (roof > 0.0 ? r.gbps() / roof : 0.0)
+                << " of stream\n";
+    }
+    bench::do_not_optimize(e(0));
+  }
+
+  report.print();
+  report.save_csv("sweep_result.csv");
+  report.save_json("sweep_result.json");
+
+  std::ofstream roofline("sweep_roofline.csv");
+  roofline << "scenario,kernel,flops_per_byte,gbps,stream_gbps,fraction_of_stream\n";
+  for (const auto& row : roofline_rows) roofline << row << "\n";
+
+  std::cout << "test complete" << std::endl;
+  return 0;
+}